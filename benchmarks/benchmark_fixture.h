@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TVS_BENCHMARKS_BENCHMARK_FIXTURE_H_INCLUDED_
+#define TVS_BENCHMARKS_BENCHMARK_FIXTURE_H_INCLUDED_
+
+#include "tvs/tracing.h"
+
+#include <benchmark/benchmark.h>
+
+#include <ostream>
+#include <streambuf>
+
+/// convenience helpers shared by the benchmarks
+namespace bench {
+
+/**
+ * \brief integral durations, independent of the time type in use
+ *
+ * The native time type is a floating-point quantity, therefore the
+ * benchmarks stick to whole seconds there to keep splits and merges exact.
+ * Returning a duration selects the relative push/commit overloads.
+ */
+inline tracing::timed_duration
+ticks(double val)
+{
+#ifdef SYSX_NO_SYSTEMC
+  return tracing::time_type(val * sysx::si::seconds);
+#else
+  return tracing::time_type(val, sc_core::SC_NS);
+#endif
+}
+
+/// generate a fresh object name, streams are registered by name
+inline const char*
+unique_name(const char* nm)
+{
+  return tracing::host::gen_unique_name(nm);
+}
+
+/// stream buffer which formats into a fixed buffer and discards the result
+class discard_buffer : public std::streambuf
+{
+public:
+  discard_buffer() { reset(); }
+
+protected:
+  int_type overflow(int_type c) override
+  {
+    reset();
+    return traits_type::not_eof(c);
+  }
+
+private:
+  void reset() { setp(buf_, buf_ + sizeof(buf_)); }
+
+  char buf_[4096];
+};
+
+/// output stream for sinks whose output is not of interest
+class discard_stream : public std::ostream
+{
+public:
+  discard_stream()
+    : std::ostream(&buf_)
+  {}
+
+private:
+  discard_buffer buf_;
+};
+
+} // namespace bench
+
+#endif // TVS_BENCHMARKS_BENCHMARK_FIXTURE_H_INCLUDED_
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark_fixture.h"
+
+#include "tvs/tracing.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <set>
+#include <vector>
+
+/// commit a stream to \a range(0) attached readers
+template<typename Traits>
+static void
+BM_ReaderFanout(benchmark::State& state)
+{
+  using value_type = typename Traits::value_type;
+  using writer_type = tracing::timed_writer<value_type, Traits>;
+  using reader_type = tracing::timed_reader<value_type, Traits>;
+
+  writer_type writer(bench::unique_name("writer"), tracing::STREAM_CREATE);
+
+  std::vector<std::unique_ptr<reader_type>> readers;
+  for (int i = 0; i < state.range(0); ++i)
+    readers.emplace_back(
+      new reader_type(bench::unique_name("reader"), writer.name()));
+
+  auto const dur = bench::ticks(10);
+  int const batch = 16;
+
+  for (auto _ : state) {
+    for (int i = 0; i < batch; ++i)
+      writer.push(static_cast<value_type>(i % 2), dur);
+    writer.commit();
+
+    for (auto& rd : readers)
+      rd->pop_all();
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_ReaderFanout, tracing::timed_state_traits<int>)
+  ->Arg(1)
+  ->Arg(4)
+  ->Arg(16)
+  ->Arg(64);
+BENCHMARK_TEMPLATE(BM_ReaderFanout, tracing::timed_process_traits<double>)
+  ->Arg(1)
+  ->Arg(4)
+  ->Arg(16)
+  ->Arg(64);
+
+/// commit an event stream to \a range(0) readers, which copies the event
+/// sets for all but the last reader
+template<typename Set>
+static void
+BM_EventReaderFanout(benchmark::State& state)
+{
+  using writer_type = tracing::timed_event_writer<int, Set>;
+  using reader_type = typename writer_type::stream_type::reader_type;
+
+  writer_type writer(bench::unique_name("writer"), tracing::STREAM_CREATE);
+
+  std::vector<std::unique_ptr<reader_type>> readers;
+  for (int i = 0; i < state.range(0); ++i)
+    readers.emplace_back(
+      new reader_type(bench::unique_name("reader"), writer.stream()));
+
+  int const batch = 16;
+
+  for (auto _ : state) {
+    for (int i = 0; i < batch; ++i)
+      writer.push(i % 4, bench::ticks(10.0 * (i + 1)));
+    writer.commit();
+
+    for (auto& rd : readers)
+      rd->pop_all();
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_EventReaderFanout, std::set<int>)
+  ->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(BM_EventReaderFanout, tracing::small_event_set<int>)
+  ->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(BM_EventReaderFanout, tracing::bitmask_event_set<int>)
+  ->Arg(1)->Arg(4)->Arg(16);
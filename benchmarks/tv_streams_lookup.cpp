@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark_fixture.h"
+
+#include "tvs/tracing.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using process_traits = tracing::timed_process_traits<double>;
+using stream_type = tracing::timed_stream<double, process_traits>;
+
+/// \a range(0) streams, as created during elaboration
+struct lookup_setup
+{
+  explicit lookup_setup(benchmark::State const& state)
+  {
+    for (int i = 0; i < state.range(0); ++i) {
+      streams.emplace_back(new stream_type(bench::unique_name("stream")));
+      names.emplace_back(streams.back()->name());
+    }
+  }
+
+  std::vector<std::unique_ptr<stream_type>> streams;
+  std::vector<std::string> names;
+};
+
+/// untyped lookup of all streams by name
+static void
+BM_StreamLookup(benchmark::State& state)
+{
+  lookup_setup setup(state);
+
+  for (auto _ : state) {
+    for (auto const& nm : setup.names)
+      benchmark::DoNotOptimize(tracing::host::lookup(nm.c_str()));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StreamLookup)->Arg(16)->Arg(1024)->Arg(16384);
+
+/// typed lookup of all streams by name
+static void
+BM_StreamByName(benchmark::State& state)
+{
+  lookup_setup setup(state);
+
+  for (auto _ : state) {
+    for (auto const& nm : setup.names)
+      benchmark::DoNotOptimize(
+        &tracing::stream_by_name<stream_type>(nm.c_str()));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StreamByName)->Arg(16)->Arg(1024)->Arg(16384);
+
+/// generate names for a base name which is already taken
+static void
+BM_GenUniqueName(benchmark::State& state)
+{
+  stream_type taken(bench::unique_name("taken"));
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(tracing::host::gen_unique_name(taken.name()));
+}
+BENCHMARK(BM_GenUniqueName);
@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark_fixture.h"
+
+#include "tvs/tracing.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using process_traits = tracing::timed_process_traits<double>;
+using stream_type = tracing::timed_stream<double, process_traits>;
+using writer_type = stream_type::writer_type;
+using reader_type = stream_type::reader_type;
+
+/// push through a chain of \a range(0) single-input plus processors
+static void
+BM_ProcessorChain(benchmark::State& state)
+{
+  using processor_type =
+    tracing::timed_stream_processor_plus<double, process_traits>;
+
+  writer_type writer(bench::unique_name("writer"), tracing::STREAM_CREATE);
+
+  std::vector<std::unique_ptr<stream_type>> stages;
+  std::vector<std::unique_ptr<processor_type>> procs;
+
+  auto* upstream = static_cast<stream_type*>(&writer.stream());
+  for (int i = 0; i < state.range(0); ++i) {
+    stages.emplace_back(new stream_type(bench::unique_name("stage")));
+    procs.emplace_back(new processor_type());
+    procs.back()->in(*upstream);
+    procs.back()->out(*stages.back());
+    upstream = stages.back().get();
+  }
+
+  reader_type reader(bench::unique_name("reader"), *upstream);
+
+  auto const dur = bench::ticks(10);
+  int const batch = 16;
+
+  for (auto _ : state) {
+    for (int i = 0; i < batch; ++i)
+      writer.push(1.0 * i, dur);
+    writer.commit();
+    reader.pop_all();
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_ProcessorChain)->Arg(1)->Arg(4)->Arg(12);
+
+/// sum up \a range(0) streams with a single plus processor
+static void
+BM_ProcessorFanin(benchmark::State& state)
+{
+  using processor_type =
+    tracing::timed_stream_processor_plus<double, process_traits>;
+
+  std::vector<std::unique_ptr<writer_type>> writers;
+  processor_type proc;
+  stream_type result(bench::unique_name("result"));
+
+  for (int i = 0; i < state.range(0); ++i) {
+    writers.emplace_back(
+      new writer_type(bench::unique_name("writer"), tracing::STREAM_CREATE));
+    proc.in(*writers.back());
+  }
+  proc.out(result);
+
+  reader_type reader(bench::unique_name("reader"), result);
+
+  auto const dur = bench::ticks(10);
+  int const batch = 16;
+
+  for (auto _ : state) {
+    for (auto& w : writers) {
+      for (int i = 0; i < batch; ++i)
+        w->push(1.0 * i, dur);
+      w->commit();
+    }
+    reader.pop_all();
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch * state.range(0));
+}
+BENCHMARK(BM_ProcessorFanin)->Arg(2)->Arg(8)->Arg(32);
+
+/// push through \a range(0) independent branches of 4 plus processors each,
+/// notified concurrently on \a range(1) threads
+static void
+BM_ProcessorWide(benchmark::State& state)
+{
+  using processor_type =
+    tracing::timed_stream_processor_plus<double, process_traits>;
+
+  writer_type writer(bench::unique_name("writer"), tracing::STREAM_CREATE);
+
+  std::vector<std::unique_ptr<stream_type>> stages;
+  std::vector<std::unique_ptr<processor_type>> procs;
+  std::vector<std::unique_ptr<reader_type>> readers;
+
+  for (int b = 0; b < state.range(0); ++b) {
+    auto* upstream = static_cast<stream_type*>(&writer.stream());
+    for (int i = 0; i < 4; ++i) {
+      stages.emplace_back(new stream_type(bench::unique_name("stage")));
+      procs.emplace_back(new processor_type());
+      procs.back()->in(*upstream);
+      procs.back()->out(*stages.back());
+      upstream = stages.back().get();
+    }
+    readers.emplace_back(
+      new reader_type(bench::unique_name("reader"), *upstream));
+  }
+
+  auto const threads = static_cast<unsigned>(state.range(1));
+  tracing::set_sync_concurrency(threads);
+  tracing::set_notify_mode(threads > 1 ? tracing::notify_mode::parallel
+                                       : tracing::notify_mode::immediate);
+
+  auto const dur = bench::ticks(10);
+  int const batch = 16;
+
+  for (auto _ : state) {
+    for (int i = 0; i < batch; ++i)
+      writer.push(1.0 * i, dur);
+    writer.commit();
+    for (auto& r : readers)
+      r->pop_all();
+  }
+
+  tracing::set_notify_mode(tracing::notify_mode::immediate);
+  tracing::set_sync_concurrency(1);
+
+  state.SetItemsProcessed(state.iterations() * batch * state.range(0));
+}
+BENCHMARK(BM_ProcessorWide)
+  ->Args({ 16, 1 })
+  ->Args({ 16, 2 })
+  ->Args({ 16, 4 })
+  ->UseRealTime();
+
+/// single-input processor applying \a F per tuple
+template<typename F>
+struct unary_stage : tracing::timed_stream_processor_base
+{
+  unary_stage(stream_type& in, stream_type& out)
+    : reader_(this->in(in))
+    , writer_(this->out(out))
+  {}
+
+protected:
+  duration_type process(duration_type dur) override
+  {
+    double v;
+    if (f_(reader_->front(dur).value(), v))
+      writer_->push(v, dur);
+    else
+      writer_->push(process_traits::empty_policy::empty(dur));
+    reader_->pop();
+    return dur;
+  }
+
+private:
+  F f_;
+  std::shared_ptr<reader_type> reader_;
+  std::shared_ptr<writer_type> writer_;
+};
+
+struct scale_fn
+{
+  bool operator()(double v, double& out) { return out = 2 * v, true; }
+};
+
+struct positive_fn
+{
+  bool operator()(double v, double& out) { return out = v, v > 0; }
+};
+
+struct sum_fn
+{
+  double acc = 0;
+  bool operator()(double v, double& out) { return out = acc += v, true; }
+};
+
+/// map/filter/scan with a stream per stage (\a range(0) == 0) or fused into
+/// a single pipeline processor
+static void
+BM_PipelineStages(benchmark::State& state)
+{
+  writer_type writer(bench::unique_name("writer"), tracing::STREAM_CREATE);
+  auto& source = static_cast<stream_type&>(writer.stream());
+  stream_type result(bench::unique_name("result"));
+
+  std::vector<std::unique_ptr<stream_type>> stages;
+  std::vector<std::shared_ptr<void>> procs;
+
+  if (state.range(0) == 0) {
+    stages.emplace_back(new stream_type(bench::unique_name("stage")));
+    stages.emplace_back(new stream_type(bench::unique_name("stage")));
+    procs.push_back(
+      std::make_shared<unary_stage<scale_fn>>(source, *stages[0]));
+    procs.push_back(
+      std::make_shared<unary_stage<positive_fn>>(*stages[0], *stages[1]));
+    procs.push_back(std::make_shared<unary_stage<sum_fn>>(*stages[1], result));
+  } else {
+    procs.emplace_back(
+      tracing::pipeline(source)
+        .map([](double v) { return 2 * v; })
+        .filter([](double v) { return v > 0; })
+        .scan([](double acc, double v) { return acc + v; }, 0.0)
+        .to(result));
+  }
+
+  reader_type reader(bench::unique_name("reader"), result);
+
+  auto const dur = bench::ticks(10);
+  int const batch = 16;
+
+  for (auto _ : state) {
+    for (int i = 0; i < batch; ++i)
+      writer.push(1.0 * i, dur);
+    writer.commit();
+    reader.pop_all();
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch);
+  state.SetLabel(state.range(0) ? "fused" : "staged");
+}
+BENCHMARK(BM_PipelineStages)->Arg(0)->Arg(1);
+
+/// sum up two streams with the binop processor (\a range(0) == 0) or a typed
+/// zip processor
+static void
+BM_ProcessorZip(benchmark::State& state)
+{
+  writer_type a(bench::unique_name("writer"), tracing::STREAM_CREATE);
+  writer_type b(bench::unique_name("writer"), tracing::STREAM_CREATE);
+  stream_type result(bench::unique_name("result"));
+
+  std::shared_ptr<void> proc;
+  if (state.range(0) == 0) {
+    auto binop = std::make_shared<
+      tracing::timed_stream_processor_plus<double, process_traits>>();
+    binop->in(a);
+    binop->in(b);
+    binop->out(result);
+    proc = binop;
+  } else {
+    proc = tracing::make_zip_processor(
+      [](double x, double y) { return x + y; },
+      result,
+      static_cast<stream_type&>(a.stream()),
+      static_cast<stream_type&>(b.stream()));
+  }
+
+  reader_type reader(bench::unique_name("reader"), result);
+
+  auto const dur = bench::ticks(10);
+  int const batch = 16;
+
+  for (auto _ : state) {
+    for (int i = 0; i < batch; ++i) {
+      a.push(1.0 * i, dur);
+      b.push(2.0 * i, dur);
+    }
+    a.commit();
+    b.commit();
+    reader.pop_all();
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch);
+  state.SetLabel(state.range(0) ? "zip" : "binop");
+}
+BENCHMARK(BM_ProcessorZip)->Arg(0)->Arg(1);
+
+/// sliding mean/min/max over \a range(0) hops per window
+static void
+BM_WindowAggregator(benchmark::State& state)
+{
+  using aggregator_type = tracing::timed_stream_window_aggregator<>;
+  using value_stream_type = aggregator_type::stream_type;
+
+  auto const dur = bench::ticks(10);
+  auto const hop = bench::ticks(40);
+
+  value_stream_type::writer_type in(bench::unique_name("writer"),
+                                    tracing::STREAM_CREATE);
+  value_stream_type mean(bench::unique_name("mean"));
+  value_stream_type min(bench::unique_name("min"));
+  value_stream_type max(bench::unique_name("max"));
+
+  aggregator_type aggregator(hop * static_cast<double>(state.range(0)), hop);
+  aggregator.in(in);
+  aggregator.mean_out(mean);
+  aggregator.min_out(min);
+  aggregator.max_out(max);
+
+  value_stream_type::reader_type mean_reader(bench::unique_name("reader"),
+                                             mean);
+  value_stream_type::reader_type min_reader(bench::unique_name("reader"), min);
+  value_stream_type::reader_type max_reader(bench::unique_name("reader"), max);
+
+  int const batch = 64;
+  for (auto _ : state) {
+    for (int i = 0; i < batch; ++i)
+      in.push(1.0 * (i % 7), dur);
+    in.commit();
+    mean_reader.pop_all();
+    min_reader.pop_all();
+    max_reader.pop_all();
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_WindowAggregator)->Arg(1)->Arg(16)->Arg(256);
+
+/// format \a range(0) process streams to VCD
+static void
+BM_VcdFormatting(benchmark::State& state)
+{
+  bench::discard_stream out;
+
+  std::vector<std::unique_ptr<writer_type>> writers;
+  for (int i = 0; i < state.range(0); ++i)
+    writers.emplace_back(
+      new writer_type(bench::unique_name("writer"), tracing::STREAM_CREATE));
+
+  {
+    tracing::timed_stream_vcd_processor vcd(bench::unique_name("vcd"), out);
+    for (auto& w : writers)
+      vcd.add(*w);
+
+    auto const dur = bench::ticks(10);
+    int const batch = 16;
+
+    for (auto _ : state) {
+      for (auto& w : writers) {
+        for (int i = 0; i < batch; ++i)
+          w->push(1.0 * (i % 3), dur);
+        w->commit();
+      }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch * state.range(0));
+  }
+}
+BENCHMARK(BM_VcdFormatting)->Arg(1)->Arg(8)->Arg(64);
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark_fixture.h"
+
+#include "tvs/tracing.h"
+
+#include <benchmark/benchmark.h>
+
+/// push tuples with an explicit duration and commit every \a range(0) pushes
+template<typename Traits>
+static void
+BM_PushCommit(benchmark::State& state)
+{
+  using value_type = typename Traits::value_type;
+  using writer_type = tracing::timed_writer<value_type, Traits>;
+  using reader_type = tracing::timed_reader<value_type, Traits>;
+
+  writer_type writer(bench::unique_name("writer"), tracing::STREAM_CREATE);
+  reader_type reader(bench::unique_name("reader"), writer.name());
+
+  auto const batch = state.range(0);
+  auto const dur = bench::ticks(10);
+
+  for (auto _ : state) {
+    for (int i = 0; i < batch; ++i)
+      writer.push(static_cast<value_type>(i % 2), dur);
+    writer.commit();
+    reader.pop_all();
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch);
+}
+
+BENCHMARK_TEMPLATE(BM_PushCommit, tracing::timed_state_traits<int>)
+  ->Arg(1)
+  ->Arg(16)
+  ->Arg(256);
+BENCHMARK_TEMPLATE(BM_PushCommit, tracing::timed_process_traits<double>)
+  ->Arg(1)
+  ->Arg(16)
+  ->Arg(256);
+
+/// push indefinite state values followed by a commit of the given duration
+static void
+BM_StatePushIndefinite(benchmark::State& state)
+{
+  using traits_type = tracing::timed_state_traits<int>;
+  using writer_type = tracing::timed_writer<int, traits_type>;
+  using reader_type = tracing::timed_reader<int, traits_type>;
+
+  writer_type writer(bench::unique_name("writer"), tracing::STREAM_CREATE);
+  reader_type reader(bench::unique_name("reader"), writer.name());
+
+  auto const dur = bench::ticks(10);
+  int value = 0;
+
+  for (auto _ : state) {
+    writer.push(value++);
+    writer.commit(dur);
+    reader.pop_all();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StatePushIndefinite);
+
+/// push events at increasing offsets and commit every \a range(0) events
+static void
+BM_EventPushCommit(benchmark::State& state)
+{
+  using writer_type = tracing::timed_event_writer<int>;
+  using reader_type = writer_type::stream_type::reader_type;
+
+  writer_type writer(bench::unique_name("writer"), tracing::STREAM_CREATE);
+  reader_type reader(bench::unique_name("reader"), writer.stream());
+
+  auto const batch = state.range(0);
+
+  for (auto _ : state) {
+    for (int i = 0; i < batch; ++i)
+      writer.push(i % 4, bench::ticks(10.0 * (i + 1)));
+    writer.commit();
+    reader.pop_all();
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_EventPushCommit)->Arg(1)->Arg(16)->Arg(256);
+
+/// state traits folding zero-time tuples into their successor
+struct absorbing_state_traits : tracing::timed_state_traits<int>
+{
+  typedef tracing::timed_zero_time_policy_absorb<int> zero_time_policy;
+};
+
+/// push a zero-time glitch before each tuple, reports the tuples per push
+/// arriving at the reader
+template<typename Traits>
+static void
+BM_ZeroTimePush(benchmark::State& state)
+{
+  using writer_type = tracing::timed_writer<int, Traits>;
+  using reader_type = tracing::timed_reader<int, Traits>;
+
+  writer_type writer(bench::unique_name("writer"), tracing::STREAM_CREATE);
+  reader_type reader(bench::unique_name("reader"), writer.name());
+
+  auto const batch = state.range(0);
+  auto const dur = bench::ticks(10);
+  std::size_t tuples = 0;
+
+  for (auto _ : state) {
+    for (int i = 0; i < batch; ++i) {
+      writer.push(-1, tracing::timed_duration::zero_time);
+      writer.push(i % 2, dur);
+    }
+    writer.commit();
+    tuples += reader.count();
+    reader.pop_all();
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch);
+  state.counters["tuples_per_push"] =
+    static_cast<double>(tuples) / (state.iterations() * batch);
+}
+
+BENCHMARK_TEMPLATE(BM_ZeroTimePush, tracing::timed_state_traits<int>)
+  ->Arg(16)
+  ->Arg(256);
+BENCHMARK_TEMPLATE(BM_ZeroTimePush, absorbing_state_traits)->Arg(16)->Arg(256);
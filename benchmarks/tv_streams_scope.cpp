@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark_fixture.h"
+
+#include "tvs/tracing.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using process_traits = tracing::timed_process_traits<double>;
+using writer_type = tracing::timed_writer<double, process_traits>;
+
+/// scope with \a range(0) non-stream children and \a range(1) streams
+struct scope_setup
+{
+  explicit scope_setup(benchmark::State const& state)
+    : scope(bench::unique_name("module"))
+  {
+    tracing::host::scope_guard enter(scope);
+
+    for (int i = 0; i < state.range(0); ++i)
+      children.emplace_back(
+        new tracing::object_scope(bench::unique_name("child")));
+
+    for (int i = 0; i < state.range(1); ++i)
+      writers.emplace_back(
+        new writer_type(bench::unique_name("writer"), tracing::STREAM_CREATE));
+  }
+
+  tracing::object_scope scope;
+  std::vector<std::unique_ptr<tracing::object_scope>> children;
+  std::vector<std::unique_ptr<writer_type>> writers;
+};
+
+/// synchronisation point on the cached per-scope stream list
+static void
+BM_ScopeSync(benchmark::State& state)
+{
+  scope_setup setup(state);
+  tracing::host::scope_guard enter(setup.scope);
+
+  auto const dur = bench::ticks(10);
+
+  for (auto _ : state) {
+    for (auto& w : setup.writers)
+      w->push(1.0, dur);
+    benchmark::DoNotOptimize(tracing::sync());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+/// reference: synchronisation point scanning all children of the scope
+static void
+BM_ScopeScan(benchmark::State& state)
+{
+  scope_setup setup(state);
+
+  auto const dur = bench::ticks(10);
+
+  for (auto _ : state) {
+    for (auto& w : setup.writers)
+      w->push(1.0, dur);
+
+    tracing::time_type until;
+    for (auto* obj : setup.scope.get_child_objects()) {
+      auto* stream = dynamic_cast<tracing::timed_stream_base*>(obj);
+      if (stream != nullptr)
+        until = std::max(until, stream->end_time());
+    }
+    for (auto* obj : setup.scope.get_child_objects()) {
+      auto* stream = dynamic_cast<tracing::timed_stream_base*>(obj);
+      if (stream != nullptr)
+        stream->commit(until);
+    }
+    benchmark::DoNotOptimize(until);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+BENCHMARK(BM_ScopeSync)->Args({ 0, 4 })->Args({ 256, 4 })->Args({ 4096, 4 });
+BENCHMARK(BM_ScopeScan)->Args({ 0, 4 })->Args({ 256, 4 })->Args({ 4096, 4 });
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark_fixture.h"
+
+#include "tvs/tracing.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+using process_traits = tracing::timed_process_traits<double>;
+
+/// push \a range(0) tuples at out-of-order offsets, which all need to be
+/// merged into the future of the stream (merge_future)
+static void
+BM_MergeFutureOutOfOrder(benchmark::State& state)
+{
+  using writer_type = tracing::timed_writer<double, process_traits>;
+  using reader_type = tracing::timed_reader<double, process_traits>;
+
+  writer_type writer(bench::unique_name("writer"), tracing::STREAM_CREATE);
+  reader_type reader(bench::unique_name("reader"), writer.name());
+
+  auto const batch = state.range(0);
+
+  // fixed seed to get reproducible offsets
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> offset(0, 1000);
+  std::vector<tracing::timed_duration> offsets;
+  for (int i = 0; i < batch; ++i)
+    offsets.push_back(bench::ticks(offset(gen)));
+
+  auto const dur = bench::ticks(25);
+
+  for (auto _ : state) {
+    for (auto const& off : offsets)
+      writer.push(off, 1.0, dur);
+    writer.commit(bench::ticks(1025));
+    reader.pop_all();
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_MergeFutureOutOfOrder)->Arg(4)->Arg(32)->Arg(256);
+
+/// split a sequence of \a range(0) tuples in the middle of each tuple
+static void
+BM_SequenceSplit(benchmark::State& state)
+{
+  using sequence_type = tracing::timed_sequence<double, process_traits>;
+
+  auto const len = state.range(0);
+  auto const dur = bench::ticks(10);
+
+  sequence_type seq;
+  for (int i = 0; i < len; ++i)
+    seq.push_back(1.0, dur);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    sequence_type copy = seq;
+    state.ResumeTiming();
+
+    for (int i = 0; i < len; ++i)
+      copy.split(bench::ticks(10.0 * i + 5));
+
+    benchmark::DoNotOptimize(copy.size());
+  }
+
+  state.SetItemsProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_SequenceSplit)->Arg(16)->Arg(256)->Arg(1024);
+
+/// split the front of the sequence and pop it, as readers do when consuming
+/// partial tuples
+static void
+BM_SequenceSplitPopFront(benchmark::State& state)
+{
+  using sequence_type = tracing::timed_sequence<double, process_traits>;
+
+  auto const len = state.range(0);
+  auto const dur = bench::ticks(10);
+  auto const half = bench::ticks(5);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    sequence_type seq;
+    for (int i = 0; i < len; ++i)
+      seq.push_back(1.0, dur);
+    state.ResumeTiming();
+
+    while (!seq.empty()) {
+      seq.split(half);
+      seq.pop_front(half);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_SequenceSplitPopFront)->Arg(16)->Arg(256);
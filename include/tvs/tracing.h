@@ -41,16 +41,23 @@ namespace tracing {
 #include <tvs/tracing/timed_sequence.h>
 #include <tvs/tracing/timed_stream.h>
 #include <tvs/tracing/timed_value.h>
+#include <tvs/tracing/timed_window_view.h>
 
 #include <tvs/tracing/timed_variant.h>
 
 #include <tvs/tracing/timed_reader.h>
 #include <tvs/tracing/timed_writer.h>
 
+#include <tvs/tracing/processors/timed_stream_decimator.h>
+#include <tvs/tracing/processors/timed_stream_energy_integrator.h>
+#include <tvs/tracing/processors/timed_stream_pipeline.h>
 #include <tvs/tracing/processors/timed_stream_print_processor.h>
 #include <tvs/tracing/processors/timed_stream_processor_base.h>
 #include <tvs/tracing/processors/timed_stream_processor_binop.h>
+#include <tvs/tracing/processors/timed_stream_residency_processor.h>
 #include <tvs/tracing/processors/timed_stream_vcd_processor.h>
+#include <tvs/tracing/processors/timed_stream_window_aggregator.h>
+#include <tvs/tracing/processors/timed_stream_zip_processor.h>
 
 #include <tvs/tracing/timed_stream_traits.h>
 
@@ -59,6 +66,9 @@ namespace tracing {
 #include <tvs/tracing/timed_var.h>
 #include <tvs/tracing/timed_annotation.h>
 
+#include <tvs/tracing/timed_compressed_sequence.h>
+#include <tvs/tracing/timed_packed_sequence.h>
+
 #endif /* TVS_H_INCLUDED_ */
 /* Taf!
  * :tag: (tracing,h)
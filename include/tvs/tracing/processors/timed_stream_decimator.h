@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_stream_decimator.h
+ * \brief  downsampling of streams to a coarser time grid
+ * \see    timed_stream_processor_base.h, timed_stream_policies.h
+ */
+
+#ifndef TVS_TIMED_STREAM_DECIMATOR_H_INCLUDED_
+#define TVS_TIMED_STREAM_DECIMATOR_H_INCLUDED_
+
+#include <tvs/tracing/processors/timed_stream_processor_base.h>
+
+#include <tvs/tracing/timed_reader.h>
+#include <tvs/tracing/timed_stream.h>
+#include <tvs/tracing/timed_stream_policies.h>
+#include <tvs/tracing/timed_writer.h>
+
+#include <tvs/utils/assert.h>
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tracing {
+
+/* ------------------------- reduction policies ------------------------ */
+
+/**
+ * \name reduction policies
+ *
+ * A reduction combines the (split) tuples within a bucket of the decimator
+ * to a single value:
+ * \code
+ * void add(tuple_type const&);  // next tuple of the bucket
+ * value_type value() const;     // result for the bucket
+ * void reset();                 // start the next bucket
+ * \endcode
+ */
+///\{
+
+/// combine the values by the merge policy of the traits
+/// (e.g. the sum for process streams, the union for event streams)
+template<typename T, typename Traits>
+struct timed_reduction_merge
+{
+  typedef T value_type;
+  typedef timed_value<T> tuple_type;
+  typedef typename Traits::merge_policy merge_policy;
+
+  void add(tuple_type const& t)
+  {
+    // the merge policies only combine tuples of the same duration
+    tuple_type v(t.value(), timed_duration());
+    if (valid_)
+      merge_policy::merge(acc_, v);
+    else
+      acc_ = v;
+    valid_ = true;
+  }
+
+  value_type value() const { return acc_.value(); }
+
+  void reset()
+  {
+    acc_ = tuple_type();
+    valid_ = false;
+  }
+
+private:
+  tuple_type acc_;
+  bool valid_ = false;
+};
+
+/// keep the last value of the bucket
+template<typename T, typename Traits>
+struct timed_reduction_last
+{
+  typedef T value_type;
+  typedef timed_value<T> tuple_type;
+
+  void add(tuple_type const& t) { last_ = t.value(); }
+  value_type value() const { return last_; }
+  void reset() {}
+
+private:
+  value_type last_{};
+};
+
+/// value with the longest total duration within the bucket (the earliest
+/// of these on ties)
+template<typename T, typename Traits>
+struct timed_reduction_mode
+{
+  typedef T value_type;
+  typedef timed_value<T> tuple_type;
+  typedef typename tuple_type::duration_type duration_type;
+
+  void add(tuple_type const& t)
+  {
+    auto it = std::find_if(
+      hist_.begin(), hist_.end(), [&t](entry_type const& e) {
+        return e.first == t.value();
+      });
+    if (it == hist_.end())
+      hist_.emplace_back(t.value(), t.duration());
+    else
+      it->second += t.duration();
+  }
+
+  value_type value() const
+  {
+    SYSX_ASSERT(!hist_.empty());
+    auto it = std::max_element(
+      hist_.begin(), hist_.end(), [](entry_type const& a, entry_type const& b) {
+        return a.second < b.second;
+      });
+    return it->first;
+  }
+
+  void reset() { hist_.clear(); }
+
+private:
+  typedef std::pair<value_type, duration_type> entry_type;
+  std::vector<entry_type> hist_; // few distinct values per bucket
+};
+
+///\}
+
+/// default reduction of a stream: the last value for state-like streams
+/// (split_policy keep), otherwise the merge policy
+template<typename T, typename Traits>
+using timed_default_reduction = typename std::conditional<
+  std::is_same<typename Traits::split_policy,
+               timed_split_policy_keep<T>>::value,
+  timed_reduction_last<T, Traits>,
+  timed_reduction_merge<T, Traits>>::type;
+
+/* ----------------------------- decimator ----------------------------- */
+
+/**
+ * \brief processor mapping a stream onto a coarser time grid
+ *
+ * \tparam T, Traits the stream type of the input and the output
+ * \tparam Reduction reduction of the tuples within a bucket, see above
+ *
+ * The time is divided into buckets of the given resolution, starting at time
+ * zero, such that the output has at most one tuple per resolution (i.e. a
+ * maximum tuple rate of 1/resolution).  The input tuples are split at the
+ * bucket boundaries according to the split policy of the input and combined
+ * by the reduction:
+ *  - process streams: the sum of the prorated values, i.e. the totals (e.g.
+ *    energy) are preserved,
+ *  - state streams: the last value within the bucket (or the dominating one
+ *    with timed_reduction_mode),
+ *  - event streams: the union of the events, reported at the end of the
+ *    bucket.
+ * Consecutive buckets reduced to the empty value of the stream are emitted as
+ * a single empty tuple.  Otherwise, the output is joined according to its join
+ * policy, i.e. state streams only emit a tuple when the reduced value changes.
+ *
+ * The output is only committed up to the end of the last completed bucket.
+ */
+template<typename T,
+         typename Traits,
+         typename Reduction = timed_default_reduction<T, Traits>>
+class timed_stream_decimator : public timed_stream_processor_base
+{
+public:
+  using base_type = timed_stream_processor_base;
+  using stream_type = timed_stream<T, Traits>;
+  using writer_type = typename stream_type::writer_type;
+  using reduction_type = Reduction;
+
+  explicit timed_stream_decimator(duration_type const& resolution,
+                                  Reduction reduction = Reduction())
+    : resolution_(resolution)
+    , reduction_(std::move(reduction))
+  {
+    SYSX_ASSERT(resolution_ > duration_type::zero_time);
+    SYSX_ASSERT(!resolution_.is_infinite());
+  }
+
+  void in(stream_type& stream)
+  {
+    SYSX_ASSERT(!reader_ && "input already bound");
+    reader_ = base_type::in(stream);
+  }
+
+  void in(writer_type& writer)
+  {
+    auto stream = dynamic_cast<stream_type*>(&writer.stream());
+    SYSX_ASSERT(stream != nullptr);
+    in(*stream);
+  }
+
+  void out(stream_type& stream)
+  {
+    SYSX_ASSERT(!writer_ && "output already bound");
+    writer_ = base_type::out(stream);
+  }
+
+  duration_type const& resolution() const { return resolution_; }
+
+protected:
+  duration_type process(duration_type) override
+  {
+    duration_type done;
+    auto cur = reader_->cursor();
+    while (!cur.at_end()) {
+      SYSX_ASSERT(!cur.remaining().is_infinite() &&
+                  "cannot decimate infinite tuples");
+      done += cur.remaining();
+
+      // split the tuple at the bucket boundaries, the closing of a bucket is
+      // decided before the addition, which may round in native time
+      bool passed = false;
+      do {
+        if (!(bucket_pos_ < resolution_)) { // rounded up to the boundary
+          close_bucket();
+          continue;
+        }
+
+        auto const left = cur.remaining();
+        duration_type const bucket_left = resolution_ - bucket_pos_;
+        bool const closing = !(left < bucket_left);
+        passed = !(bucket_left < left);
+
+        auto const part = passed ? left : bucket_left;
+        reduction_.add(cur.tuple(part));
+        bucket_pos_ += part;
+        if (passed)
+          cur.next();
+        else
+          cur.advance_segment(part);
+
+        if (closing)
+          close_bucket();
+      } while (!passed);
+    }
+    reader_->pop_until(cur);
+    return done;
+  }
+
+  duration_type do_commit(duration_type until) override
+  {
+    // the output only covers the completed buckets, pending empty buckets
+    // are filled by the commit
+    for (auto&& out : outputs())
+      out->commit(emitted_until_);
+    pending_empty_ = duration_type();
+
+    return until;
+  }
+
+private:
+  using reader_type = typename stream_type::reader_type;
+  using empty_policy = typename Traits::empty_policy;
+
+  void close_bucket()
+  {
+    auto const empty = empty_policy::empty(resolution_);
+    auto const value = reduction_.value();
+    if (value == empty.value()) {
+      // coalesce consecutive empty buckets
+      pending_empty_ += resolution_;
+    } else {
+      if (pending_empty_ > duration_type::zero_time)
+        writer_->push(empty_policy::empty(pending_empty_));
+      pending_empty_ = duration_type();
+      writer_->push(value, resolution_);
+    }
+
+    reduction_.reset();
+    bucket_pos_ = duration_type();
+    emitted_until_ = emitted_until_ + resolution_;
+  }
+
+  duration_type resolution_;
+  Reduction reduction_;
+
+  duration_type bucket_pos_; ///< elapsed time within the current bucket
+  time_type emitted_until_;  ///< end of the last completed bucket
+  duration_type pending_empty_; ///< empty buckets not pushed yet
+
+  std::shared_ptr<reader_type> reader_;
+  std::shared_ptr<writer_type> writer_;
+};
+
+} // namespace tracing
+
+#endif /* TVS_TIMED_STREAM_DECIMATOR_H_INCLUDED_ */
+/* Taf!
+ */
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_stream_energy_integrator.h
+ * \brief  integration of power streams to energy
+ * \see    timed_stream_processor_base.h, tvs/units/power.h
+ */
+
+#ifndef TVS_TIMED_STREAM_ENERGY_INTEGRATOR_H_INCLUDED_
+#define TVS_TIMED_STREAM_ENERGY_INTEGRATOR_H_INCLUDED_
+
+#include <tvs/tracing/processors/timed_stream_processor_base.h>
+
+#include <tvs/tracing/timed_reader.h>
+#include <tvs/tracing/timed_stream.h>
+#include <tvs/tracing/timed_stream_traits.h>
+#include <tvs/tracing/timed_writer.h>
+
+#include <tvs/units/power.h>
+#include <tvs/utils/kahan_sum.h>
+
+#include <memory>
+#include <vector>
+
+namespace tracing {
+
+/**
+ * \brief processor integrating the total power of its inputs to energy
+ *
+ * Two kinds of inputs are supported:
+ *  - state streams of the power in watts (power_stream_type), which are
+ *    integrated over time,
+ *  - process streams of the energy in joules (energy_stream_type), e.g. the
+ *    power of a process stream whose tuples carry the energy consumed within
+ *    their duration.  Partially covered tuples are prorated according to the
+ *    split policy of the process traits, zero-time tuples add their energy
+ *    to the window containing them.
+ *
+ * The energy of all inputs is summed up and reported in joules:
+ *  - energy_out(): energy per window (process stream),
+ *  - cumulative_out(): energy since the start at the end of each window
+ *    (state stream).
+ *
+ * With a window of zero time, each aligned segment of the inputs forms a
+ * window.  Otherwise, the windows have the given duration starting at time
+ * zero, the outputs are only committed up to the end of the last completed
+ * window.
+ *
+ * All tuples available on all inputs are integrated at once, the sums are
+ * compensated to avoid the accumulation of rounding errors over long traces.
+ */
+class timed_stream_energy_integrator : public timed_stream_processor_base
+{
+public:
+  using base_type = timed_stream_processor_base;
+
+  using power_stream_type = timed_stream<double, timed_state_traits<double>>;
+  using energy_stream_type =
+    timed_stream<double, timed_process_traits<double>>;
+  using cumulative_stream_type =
+    timed_stream<double, timed_state_traits<double>>;
+
+  using energy_type = sysx::units::energy_type;
+
+  explicit timed_stream_energy_integrator(
+    duration_type const& window = duration_type());
+
+  /// add a power input (watts)
+  void in(power_stream_type& stream);
+  void in(power_stream_type::writer_type& writer);
+  /// add an energy input (joules per tuple)
+  void in(energy_stream_type& stream);
+  void in(energy_stream_type::writer_type& writer);
+
+  /// emit the energy per window to \a stream
+  void energy_out(energy_stream_type& stream);
+  /// emit the cumulative energy at the end of each window to \a stream
+  void cumulative_out(cumulative_stream_type& stream);
+
+  duration_type const& window() const { return window_; }
+
+  /// energy integrated so far (including the current window)
+  energy_type energy() const;
+  /// end of the integrated input
+  time_type integrated_until() const { return local_time(); }
+  /// energy within the current, incomplete window
+  energy_type window_energy() const;
+
+protected:
+  duration_type process(duration_type dur) override;
+  duration_type do_commit(duration_type until) override;
+
+private:
+  using power_reader_type = power_stream_type::reader_type;
+  using energy_reader_type = energy_stream_type::reader_type;
+  using power_cursor_type = power_reader_type::cursor_type;
+  using energy_cursor_type = energy_reader_type::cursor_type;
+
+  void integrate(double watts, double joules, duration_type const& seg);
+  void close_window(duration_type const& length);
+
+  duration_type window_;
+  duration_type window_pos_; ///< elapsed time within the current window
+  time_type emitted_until_;  ///< end of the last completed window
+
+  sysx::utils::kahan_sum total_;
+  sysx::utils::kahan_sum current_;
+
+  std::vector<std::shared_ptr<power_reader_type>> power_readers_;
+  std::vector<std::shared_ptr<energy_reader_type>> energy_readers_;
+  std::vector<power_cursor_type> power_cursors_;
+  std::vector<energy_cursor_type> energy_cursors_;
+  std::shared_ptr<energy_stream_type::writer_type> energy_;
+  std::shared_ptr<cumulative_stream_type::writer_type> cumulative_;
+};
+
+} // namespace tracing
+
+#endif /* TVS_TIMED_STREAM_ENERGY_INTEGRATOR_H_INCLUDED_ */
+/* Taf!
+ */
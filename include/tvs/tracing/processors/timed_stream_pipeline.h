@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_stream_pipeline.h
+ * \brief  fused single-input processor pipelines
+ * \see    timed_stream_processor_base.h
+ *
+ * A pipeline applies a sequence of value transformations to the tuples of a
+ * single input stream within a single processor:
+ * \code
+ * auto proc = tracing::pipeline(in)
+ *               .map([](double v) { return 2 * v; })
+ *               .filter([](double v) { return v > 1.0; })
+ *               .scan([](double acc, double v) { return acc + v; }, 0.0)
+ *               .to(out);
+ * \endcode
+ * The stages are composed at compile time, so no intermediate streams,
+ * readers or writers are created.  The split policy of the input is only
+ * applied when reading a tuple, the join policy of the output only when
+ * pushing the result.  Tuples rejected by a filter are replaced by an empty
+ * tuple of the output traits, which keeps the output aligned with the input.
+ */
+
+#ifndef TVS_TIMED_STREAM_PIPELINE_H_INCLUDED_
+#define TVS_TIMED_STREAM_PIPELINE_H_INCLUDED_
+
+#include <tvs/tracing/processors/timed_stream_processor_base.h>
+
+#include <tvs/tracing/timed_reader.h>
+#include <tvs/tracing/timed_stream.h>
+#include <tvs/tracing/timed_writer.h>
+
+#include <tvs/utils/assert.h>
+
+#include <memory>
+#include <utility>
+
+namespace tracing {
+
+namespace impl {
+
+/// initial pipeline stage, forwards the input values
+struct pipeline_source
+{
+  template<typename V, typename Sink>
+  void operator()(V&& v, Sink&& sink)
+  {
+    sink(std::forward<V>(v));
+  }
+};
+
+/// apply \a F to the values of the previous stages
+template<typename Prev, typename F>
+struct pipeline_map
+{
+  Prev prev;
+  F f;
+
+  template<typename V, typename Sink>
+  void operator()(V&& v, Sink&& sink)
+  {
+    prev(std::forward<V>(v),
+         [this, &sink](auto&& x) { sink(f(std::forward<decltype(x)>(x))); });
+  }
+};
+
+/// drop the values of the previous stages not satisfying \a Pred
+template<typename Prev, typename Pred>
+struct pipeline_filter
+{
+  Prev prev;
+  Pred pred;
+
+  template<typename V, typename Sink>
+  void operator()(V&& v, Sink&& sink)
+  {
+    prev(std::forward<V>(v), [this, &sink](auto&& x) {
+      if (pred(x))
+        sink(std::forward<decltype(x)>(x));
+    });
+  }
+};
+
+/// running accumulation \a acc = \a F(acc, v) of the previous stages
+template<typename Prev, typename F, typename Acc>
+struct pipeline_scan
+{
+  Prev prev;
+  F f;
+  Acc acc;
+
+  template<typename V, typename Sink>
+  void operator()(V&& v, Sink&& sink)
+  {
+    prev(std::forward<V>(v), [this, &sink](auto&& x) {
+      acc = f(acc, std::forward<decltype(x)>(x));
+      sink(static_cast<Acc const&>(acc));
+    });
+  }
+};
+
+} // namespace impl
+
+/**
+ * \brief processor running a fused pipeline from one stream to another
+ *
+ * \tparam T, Traits the input stream type
+ * \tparam Stages the composed pipeline stages
+ * \tparam U, UTraits the output stream type
+ *
+ * \see pipeline()
+ */
+template<typename T,
+         typename Traits,
+         typename Stages,
+         typename U,
+         typename UTraits>
+class timed_stream_pipeline_processor : public timed_stream_processor_base
+{
+public:
+  using base_type = timed_stream_processor_base;
+  using input_stream_type = timed_stream<T, Traits>;
+  using output_stream_type = timed_stream<U, UTraits>;
+  using reader_type = timed_reader<T, Traits>;
+  using writer_type = timed_writer<U, UTraits>;
+  using empty_policy = typename UTraits::empty_policy;
+
+  timed_stream_pipeline_processor(input_stream_type& in,
+                                  output_stream_type& out,
+                                  Stages stages)
+    : stages_(std::move(stages))
+    , reader_(base_type::in(in))
+    , writer_(base_type::out(out))
+  {}
+
+  /// push to and commit the existing writer \a out, which must not be used
+  /// otherwise and must outlive the processor
+  timed_stream_pipeline_processor(input_stream_type& in,
+                                  writer_type& out,
+                                  Stages stages)
+    : stages_(std::move(stages))
+    , reader_(base_type::in(in))
+    , writer_(&out, [](writer_type*) {}) // not owned
+  {
+    base_type::do_add_output(writer_ptr_type(writer_));
+  }
+
+protected:
+  duration_type process(duration_type dur) override
+  {
+    bool pushed = false;
+    stages_(reader_->front(dur).value(), [this, &dur, &pushed](auto&& v) {
+      writer_->push(v, dur);
+      pushed = true;
+    });
+    if (!pushed)
+      writer_->push(empty_policy::empty(dur));
+
+    reader_->pop();
+    return dur;
+  }
+
+private:
+  Stages stages_;
+  std::shared_ptr<reader_type> reader_;
+  std::shared_ptr<writer_type> writer_;
+};
+
+/**
+ * \brief builder for fused processor pipelines
+ *
+ * Each stage returns a new builder with the stage appended, to() finally
+ * creates the processor.  The stage functions are copied into the builder and
+ * the processor.
+ */
+template<typename T, typename Traits, typename Stages = impl::pipeline_source>
+class timed_pipeline
+{
+public:
+  using stream_type = timed_stream<T, Traits>;
+
+  explicit timed_pipeline(stream_type& in, Stages stages = Stages())
+    : in_(&in)
+    , stages_(std::move(stages))
+  {}
+
+  /// transform each value by \a f
+  template<typename F>
+  timed_pipeline<T, Traits, impl::pipeline_map<Stages, F>> map(F f) const
+  {
+    using stages_type = impl::pipeline_map<Stages, F>;
+    return timed_pipeline<T, Traits, stages_type>(
+      *in_, stages_type{ stages_, std::move(f) });
+  }
+
+  /// keep the values satisfying \a pred, the others are replaced by an empty
+  /// tuple of the output
+  template<typename Pred>
+  timed_pipeline<T, Traits, impl::pipeline_filter<Stages, Pred>> filter(
+    Pred pred) const
+  {
+    using stages_type = impl::pipeline_filter<Stages, Pred>;
+    return timed_pipeline<T, Traits, stages_type>(
+      *in_, stages_type{ stages_, std::move(pred) });
+  }
+
+  /// replace each value by the running accumulation \c init = f(init, v)
+  template<typename F, typename Acc>
+  timed_pipeline<T, Traits, impl::pipeline_scan<Stages, F, Acc>> scan(
+    F f,
+    Acc init) const
+  {
+    using stages_type = impl::pipeline_scan<Stages, F, Acc>;
+    return timed_pipeline<T, Traits, stages_type>(
+      *in_, stages_type{ stages_, std::move(f), std::move(init) });
+  }
+
+  /// create the processor writing to the stream \a out
+  template<typename U, typename UTraits>
+  std::unique_ptr<
+    timed_stream_pipeline_processor<T, Traits, Stages, U, UTraits>>
+  to(timed_stream<U, UTraits>& out) const
+  {
+    using processor_type =
+      timed_stream_pipeline_processor<T, Traits, Stages, U, UTraits>;
+    return std::unique_ptr<processor_type>(
+      new processor_type(*in_, out, stages_));
+  }
+
+  /// create the processor pushing through the writer \a out, the processor
+  /// takes over the writer (see timed_stream_pipeline_processor)
+  template<typename U, typename UTraits>
+  std::unique_ptr<
+    timed_stream_pipeline_processor<T, Traits, Stages, U, UTraits>>
+  to(timed_writer<U, UTraits>& out) const
+  {
+    using processor_type =
+      timed_stream_pipeline_processor<T, Traits, Stages, U, UTraits>;
+    return std::unique_ptr<processor_type>(
+      new processor_type(*in_, out, stages_));
+  }
+
+private:
+  stream_type* in_;
+  Stages stages_;
+};
+
+/// start a pipeline reading from the stream \a in
+template<typename T, typename Traits>
+timed_pipeline<T, Traits>
+pipeline(timed_stream<T, Traits>& in)
+{
+  return timed_pipeline<T, Traits>(in);
+}
+
+/// start a pipeline reading from the stream of the writer \a in
+template<typename T, typename Traits>
+timed_pipeline<T, Traits>
+pipeline(timed_writer<T, Traits>& in)
+{
+  auto stream = dynamic_cast<timed_stream<T, Traits>*>(&in.stream());
+  SYSX_ASSERT(stream != nullptr);
+  return timed_pipeline<T, Traits>(*stream);
+}
+
+} // namespace tracing
+
+#endif /* TVS_TIMED_STREAM_PIPELINE_H_INCLUDED_ */
+/* Taf!
+ */
@@ -30,6 +30,8 @@
 #include <tvs/tracing/timed_stream_base.h>
 #include <tvs/tracing/timed_writer_base.h>
 
+#include <tvs/utils/memory_resource.h>
+
 #include <memory>
 #include <unordered_set>
 
@@ -72,6 +74,7 @@ struct timed_stream_processor_base
   using writer_collection_type = std::vector<writer_ptr_type>;
 
   using duration_type = stream_base_type::duration_type;
+  using memory_resource = sysx::utils::memory_resource;
 
   /// Add an input stream of a writer to this processor.
   ///
@@ -105,6 +108,14 @@ struct timed_stream_processor_base
   std::shared_ptr<tracing::timed_writer<T, Traits>>
   out(timed_stream<T, Traits>&);
 
+  /// Memory resource for the internally created readers and writers.
+  ///
+  /// This is the default resource at construction of the processor.
+  memory_resource* resource() const { return resource_; }
+
+  /// Adds the streams of all output writers.
+  void collect_downstream(std::vector<stream_base_type*>&) const override;
+
 protected:
   timed_stream_processor_base();
 
@@ -149,6 +160,7 @@ private:
 
   void update_cache();
 
+  memory_resource* resource_;
   reader_collection_type inputs_;
   writer_collection_type outputs_;
 
@@ -178,8 +190,11 @@ timed_stream_processor_base::in(tracing::timed_stream<T, Traits>& stream)
   std::stringstream name;
   name << stream.basename() << "_reader";
 
-  auto ret = std::make_shared<reader_type>(
-    host::gen_unique_name(name.str().c_str()), stream);
+  sysx::utils::memory_resource_scope scope(*resource_);
+  auto ret = std::allocate_shared<reader_type>(
+    sysx::utils::polymorphic_allocator<reader_type>(resource_),
+    host::gen_unique_name(name.str().c_str()),
+    stream);
 
   this->do_add_input(ret);
   return ret;
@@ -203,7 +218,9 @@ timed_stream_processor_base::out(tracing::timed_stream<T, Traits>& stream)
 {
   using writer_type =
     typename std::remove_reference<decltype(stream)>::type::writer_type;
-  auto ret = std::make_shared<writer_type>(stream);
+  sysx::utils::memory_resource_scope scope(*resource_);
+  auto ret = std::allocate_shared<writer_type>(
+    sysx::utils::polymorphic_allocator<writer_type>(resource_), stream);
   this->do_add_output(ret);
   return ret;
 }
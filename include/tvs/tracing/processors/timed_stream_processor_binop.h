@@ -40,17 +40,65 @@
 
 #include <tvs/units/time.h>
 
-#include <boost/range/adaptor/transformed.hpp>
-#include <boost/range/algorithm.hpp>
-#include <boost/range/numeric.hpp>
+#include <tvs/tracing/timed_reader.h>
+#include <tvs/tracing/timed_writer.h>
 
+#include <algorithm>
+#include <functional>
+#include <limits>
 #include <map>
+#include <type_traits>
+#include <vector>
 
 namespace tracing {
 
+/**
+ * \brief properties of a binary operation \a Op on values of type \a T
+ *
+ * - \c identity: result of the operation without inputs, and right identity
+ *   of the operation (i.e. \c Op(x, identity) == x)
+ * - \c has_absorbing, \c absorbing: once the accumulated result equals the
+ *   absorbing element, it does not change anymore (e.g. multiplication by 0)
+ */
 template<typename T, typename Op>
 struct operator_traits;
 
+/// operator_traits without an absorbing element
+template<typename T>
+struct operator_traits_base
+{
+  static constexpr bool has_absorbing = false;
+  static constexpr T absorbing = T();
+};
+
+/// smaller of two values
+template<typename T>
+struct minimum
+{
+  typedef T first_argument_type;
+  typedef T second_argument_type;
+  typedef T result_type;
+
+  constexpr T operator()(T const& a, T const& b) const
+  {
+    return (b < a) ? b : a;
+  }
+};
+
+/// larger of two values
+template<typename T>
+struct maximum
+{
+  typedef T first_argument_type;
+  typedef T second_argument_type;
+  typedef T result_type;
+
+  constexpr T operator()(T const& a, T const& b) const
+  {
+    return (a < b) ? b : a;
+  }
+};
+
 /**
  * \brief Stream processor for applying a binary operation on all stream inputs
  * and committing the result to the output sink.
@@ -59,6 +107,9 @@ struct operator_traits;
  * \tparam Traits The traits type of the stream
  * \tparam BinaryOperation the operation, \see std::plus for an example
  *
+ * The operation is folded over the inputs from left to right in the order of
+ * their binding, i.e. in0 - in1 - in2 for std::minus.  All segments available
+ * on all inputs are evaluated at once.
  */
 template<typename T, typename Traits, typename BinaryOperation>
 struct timed_stream_binop_processor : timed_stream_processor_base
@@ -97,37 +148,68 @@ struct timed_stream_binop_processor : timed_stream_processor_base
 
 protected:
   /// Performs the binary operation \a BinaryOperation on all input streams for
-  /// the given duration, then pushes the accumulated result to the output
-  /// stream.
-  duration_type process(duration_type dur) override
+  /// all available segments, then pushes the results to the output streams.
+  duration_type process(duration_type) override
   {
-    using namespace boost::adaptors;
+    cursors_.clear();
+    for (auto&& i : this->inputs())
+      cursors_.push_back(static_cast<reader_type&>(*i).cursor());
+
+    duration_type done;
+    auto at_end = [](cursor_type const& cur) { return cur.at_end(); };
+    while (!cursors_.empty() &&
+           std::none_of(cursors_.begin(), cursors_.end(), at_end)) {
+      auto seg = duration_type::infinity();
+      for (auto const& cur : cursors_)
+        seg = std::min(seg, cur.remaining());
+
+      auto const result = evaluate(seg);
+      for (auto&& out : this->outputs())
+        static_cast<writer_type&>(*out).push(result, seg);
+
+      for (auto& cur : cursors_)
+        cur.advance_segment(seg);
+      done += seg;
+    }
 
-    output_type result{ op_traits::identity };
+    // consume the processed tuples
+    auto it = cursors_.begin();
+    for (auto&& i : this->inputs())
+      static_cast<reader_type&>(*i).pop_until(*it++);
+    cursors_.clear();
 
-    result = boost::accumulate(this->inputs() | transformed([&dur](auto& rd) {
-                                 auto& reader = static_cast<reader_type&>(*rd);
-                                 return reader.front(dur).value();
-                               }),
-                               result,
-                               binop_type());
+    return done;
+  }
 
-    for (auto&& out : this->outputs()) {
-      auto& wr = static_cast<writer_type&>(*out);
-      wr.push(result, dur);
-    }
+private:
+  using cursor_type = typename reader_type::cursor_type;
 
-    for (auto&& i : this->inputs()) {
-      i->pop();
+  /// fold the operation over the values of the current segment
+  output_type evaluate(duration_type const& seg) const
+  {
+    auto it = cursors_.begin();
+    output_type result = it->tuple(seg).value();
+    binop_type op;
+    for (++it; it != cursors_.end(); ++it) {
+      // short-circuit: the remaining inputs cannot change the result
+      if (op_traits::has_absorbing && result == op_traits::absorbing)
+        break;
+      result = op(result, it->tuple(seg).value());
     }
-
-    return dur;
+    return result;
   }
+
+  std::vector<cursor_type> cursors_;
 };
 
+template<typename T>
+struct operator_traits<T, std::plus<T>> : operator_traits_base<T>
+{
+  static T constexpr identity = 0;
+};
 
 template<typename T>
-struct operator_traits<T, std::plus<T>>
+struct operator_traits<T, std::minus<T>> : operator_traits_base<T>
 {
   static T constexpr identity = 0;
 };
@@ -136,6 +218,77 @@ template<typename T>
 struct operator_traits<T, std::multiplies<T>>
 {
   static T constexpr identity = 1;
+  // 0 * inf and 0 * NaN are not 0 for floating-point values
+  static constexpr bool has_absorbing = std::is_integral<T>::value;
+  static T constexpr absorbing = 0;
+};
+
+template<typename T>
+struct operator_traits<T, std::divides<T>> : operator_traits_base<T>
+{
+  static T constexpr identity = 1;
+};
+
+template<typename T>
+struct operator_traits<T, minimum<T>>
+{
+  static T constexpr identity = std::numeric_limits<T>::has_infinity
+                                  ? std::numeric_limits<T>::infinity()
+                                  : std::numeric_limits<T>::max();
+  static constexpr bool has_absorbing = true;
+  static T constexpr absorbing = std::numeric_limits<T>::has_infinity
+                                   ? -std::numeric_limits<T>::infinity()
+                                   : std::numeric_limits<T>::lowest();
+};
+
+template<typename T>
+struct operator_traits<T, maximum<T>>
+{
+  static T constexpr identity = std::numeric_limits<T>::has_infinity
+                                  ? -std::numeric_limits<T>::infinity()
+                                  : std::numeric_limits<T>::lowest();
+  static constexpr bool has_absorbing = true;
+  static T constexpr absorbing = std::numeric_limits<T>::has_infinity
+                                   ? std::numeric_limits<T>::infinity()
+                                   : std::numeric_limits<T>::max();
+};
+
+template<typename T>
+struct operator_traits<T, std::logical_and<T>>
+{
+  static T constexpr identity = true;
+  static constexpr bool has_absorbing = true;
+  static T constexpr absorbing = false;
+};
+
+template<typename T>
+struct operator_traits<T, std::logical_or<T>>
+{
+  static T constexpr identity = false;
+  static constexpr bool has_absorbing = true;
+  static T constexpr absorbing = true;
+};
+
+template<typename T>
+struct operator_traits<T, std::bit_and<T>>
+{
+  static T constexpr identity = static_cast<T>(~T(0));
+  static constexpr bool has_absorbing = true;
+  static T constexpr absorbing = 0;
+};
+
+template<typename T>
+struct operator_traits<T, std::bit_or<T>>
+{
+  static T constexpr identity = 0;
+  static constexpr bool has_absorbing = true;
+  static T constexpr absorbing = static_cast<T>(~T(0));
+};
+
+template<typename T>
+struct operator_traits<T, std::bit_xor<T>> : operator_traits_base<T>
+{
+  static T constexpr identity = 0;
 };
 
 #define _DECLARE_PROC(op)                                                      \
@@ -144,7 +297,24 @@ struct operator_traits<T, std::multiplies<T>>
     timed_stream_binop_processor<T, Traits, std::op<T>>
 
 _DECLARE_PROC(plus);
+_DECLARE_PROC(minus);
 _DECLARE_PROC(multiplies);
+_DECLARE_PROC(divides);
+_DECLARE_PROC(logical_and);
+_DECLARE_PROC(logical_or);
+_DECLARE_PROC(bit_and);
+_DECLARE_PROC(bit_or);
+_DECLARE_PROC(bit_xor);
+
+#undef _DECLARE_PROC
+
+#define _DECLARE_PROC(op)                                                      \
+  template<typename T, typename Traits>                                        \
+  using timed_stream_processor_##op =                                          \
+    timed_stream_binop_processor<T, Traits, op<T>>
+
+_DECLARE_PROC(minimum);
+_DECLARE_PROC(maximum);
 
 #undef _DECLARE_PROC
 
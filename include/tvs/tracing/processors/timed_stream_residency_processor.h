@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_stream_residency_processor.h
+ * \brief  time-in-state histograms of state and event streams
+ * \see    timed_stream_processor_base.h
+ */
+
+#ifndef TVS_TIMED_STREAM_RESIDENCY_PROCESSOR_H_INCLUDED_
+#define TVS_TIMED_STREAM_RESIDENCY_PROCESSOR_H_INCLUDED_
+
+#include <tvs/tracing/processors/timed_stream_processor_base.h>
+
+#include <tvs/tracing/timed_event_sets.h>
+#include <tvs/tracing/timed_event_writer.h>
+#include <tvs/tracing/timed_reader.h>
+#include <tvs/tracing/timed_stream.h>
+#include <tvs/tracing/timed_stream_traits.h>
+#include <tvs/tracing/timed_writer.h>
+
+#include <tvs/utils/assert.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace tracing {
+
+/**
+ * \brief processor collecting the residency per state and the transitions
+ *
+ * \tparam T the state type
+ * \tparam Value the value type of the input stream, either \a T for state
+ *         streams or an event set of \a T for event streams
+ * \tparam Traits the traits of the input stream
+ * \tparam Hash hash function of the states
+ *
+ * For state streams, the state is the value of the current tuple.  For event
+ * streams, each event enters the given state at the end of its tuple, which is
+ * held until the next event.  Simultaneous events are entered in the order of
+ * the event set, the time before the first event is reported as unknown().
+ *
+ * The states are numbered densely in the order of their first appearance, the
+ * residency and the transition matrix are indexed by these numbers.  Entering
+ * the current state again is not counted as a transition.
+ *
+ * All committed tuples of the input are consumed at once.  The queries may be
+ * called at any time (also from other threads), they return the state up to
+ * integrated_until().
+ *
+ * \see timed_state_residency, timed_event_residency
+ */
+template<typename T,
+         typename Value = T,
+         typename Traits = timed_state_traits<Value>,
+         typename Hash = std::hash<T>>
+class timed_residency_processor : public timed_stream_processor_base
+{
+public:
+  using base_type = timed_stream_processor_base;
+  using state_type = T;
+  using stream_type = timed_stream<Value, Traits>;
+  using size_type = std::size_t;
+
+  /// are the input values event sets?
+  static const bool events = is_event_set<Value>::value;
+
+  /// consistent copy of the collected statistics
+  struct snapshot_type
+  {
+    std::vector<state_type> states;       ///< in order of first appearance
+    std::vector<duration_type> residency; ///< per state
+    std::vector<std::vector<size_type>> transitions; ///< [from][to]
+    duration_type unknown;                ///< before the first state
+    time_type until;                      ///< end of the covered time
+  };
+
+  timed_residency_processor() = default;
+
+  explicit timed_residency_processor(stream_type& stream) { in(stream); }
+  explicit timed_residency_processor(typename stream_type::writer_type& writer)
+  {
+    in(writer);
+  }
+
+  void in(stream_type& stream)
+  {
+    SYSX_ASSERT(!reader_ && "input already bound");
+    reader_ = base_type::in(stream);
+  }
+
+  void in(typename stream_type::writer_type& writer)
+  {
+    auto stream = dynamic_cast<stream_type*>(&writer.stream());
+    SYSX_ASSERT(stream != nullptr);
+    in(*stream);
+  }
+
+  /// total duration spent in \a state
+  duration_type residency(state_type const& state) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(state);
+    return it == index_.end() ? duration_type() : residency_[it->second];
+  }
+
+  /// number of transitions from \a from to \a to
+  size_type transitions(state_type const& from, state_type const& to) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto f = index_.find(from);
+    auto t = index_.find(to);
+    if (f == index_.end() || t == index_.end())
+      return 0;
+    return transitions_[f->second][t->second];
+  }
+
+  /// duration before the first state
+  duration_type unknown() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return unknown_;
+  }
+
+  /// number of distinct states seen so far
+  size_type size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return states_.size();
+  }
+
+  time_type integrated_until() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return until_;
+  }
+
+  snapshot_type snapshot() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return snapshot_type{ states_, residency_, transitions_, unknown_, until_ };
+  }
+
+protected:
+  duration_type process(duration_type) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    duration_type done;
+    auto cur = reader_->cursor();
+    for (; !cur.at_end(); cur.next()) {
+      auto const dur = cur.remaining();
+      SYSX_ASSERT(!dur.is_infinite() && "cannot accumulate infinite tuples");
+
+      // events occur at the end of their tuple
+      if (!events)
+        enter(cur.tuple().value(), std::integral_constant<bool, events>());
+      if (current_ < states_.size())
+        residency_[current_] += dur;
+      else
+        unknown_ += dur;
+      if (events)
+        enter(cur.tuple().value(), std::integral_constant<bool, events>());
+      done += dur;
+    }
+    reader_->pop_until(cur);
+
+    until_ = until_ + done;
+    return done;
+  }
+
+private:
+  using reader_type = typename stream_type::reader_type;
+
+  void enter(Value const& v, std::false_type) { enter_state(v); }
+
+  void enter(Value const& v, std::true_type)
+  {
+    for (auto const& e : v)
+      enter_state(e);
+  }
+
+  void enter_state(state_type const& state)
+  {
+    auto idx = lookup(state);
+    if (current_ < states_.size() && current_ != idx)
+      ++transitions_[current_][idx];
+    current_ = idx;
+  }
+
+  size_type lookup(state_type const& state)
+  {
+    auto it = index_.find(state);
+    if (it != index_.end())
+      return it->second;
+
+    auto idx = states_.size();
+    index_.emplace(state, idx);
+    states_.push_back(state);
+    residency_.emplace_back();
+    for (auto& row : transitions_)
+      row.push_back(0);
+    transitions_.emplace_back(idx + 1, 0);
+    return idx;
+  }
+
+  std::shared_ptr<reader_type> reader_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<state_type, size_type, Hash> index_;
+  std::vector<state_type> states_;
+  std::vector<duration_type> residency_;
+  std::vector<std::vector<size_type>> transitions_;
+  size_type current_{ static_cast<size_type>(-1) };
+  duration_type unknown_;
+  time_type until_;
+};
+
+template<typename T, typename Value, typename Traits, typename Hash>
+const bool timed_residency_processor<T, Value, Traits, Hash>::events;
+
+/// residency of the values of a state stream
+template<typename T, typename Hash = std::hash<T>>
+using timed_state_residency =
+  timed_residency_processor<T, T, timed_state_traits<T>, Hash>;
+
+/// residency of the states entered by the events of an event stream
+template<typename T,
+         typename Set = event_set_type<T>,
+         typename Hash = std::hash<T>>
+using timed_event_residency =
+  timed_residency_processor<T, Set, timed_event_traits<Set>, Hash>;
+
+} // namespace tracing
+
+#endif /* TVS_TIMED_STREAM_RESIDENCY_PROCESSOR_H_INCLUDED_ */
+/* Taf!
+ */
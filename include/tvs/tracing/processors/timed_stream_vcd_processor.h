@@ -208,10 +208,11 @@ public:
   }
 
 private:
-  template<typename T>
-  void do_add_stream(event_stream_type<T>& stream,
-                     std::string scope,
-                     std::string override_name = "")
+  template<typename Set>
+  typename std::enable_if<is_event_set<Set>::value>::type do_add_stream(
+    timed_stream<Set, timed_event_traits<Set>>& stream,
+    std::string scope,
+    std::string override_name = "")
   {
     auto conv = impl::create_converter(stream);
     auto& converted_stream = conv->stream();
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_stream_window_aggregator.h
+ * \brief  time-weighted aggregation over tumbling and sliding windows
+ * \see    timed_stream_processor_base.h
+ */
+
+#ifndef TVS_TIMED_STREAM_WINDOW_AGGREGATOR_H_INCLUDED_
+#define TVS_TIMED_STREAM_WINDOW_AGGREGATOR_H_INCLUDED_
+
+#include <tvs/tracing/processors/timed_stream_processor_base.h>
+
+#include <tvs/tracing/timed_reader.h>
+#include <tvs/tracing/timed_stream.h>
+#include <tvs/tracing/timed_stream_traits.h>
+#include <tvs/tracing/timed_writer.h>
+
+#include <tvs/utils/assert.h>
+#include <tvs/utils/kahan_sum.h>
+#include <tvs/utils/quantile_sketch.h>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tracing {
+
+/**
+ * \brief processor aggregating a numeric stream over time windows
+ *
+ * The windows have the given length and advance by the given hop, starting
+ * at time zero.  Without a hop (or with a hop equal to the window), the
+ * windows are tumbling.  Otherwise, they are sliding and the window has to be
+ * a multiple of the hop.
+ *
+ * At the end of each hop, the aggregates of the last window are pushed to the
+ * bound outputs for the duration of the hop.  All aggregates are weighted by
+ * the duration of the input tuples:
+ *  - mean_out(): time-weighted mean,
+ *  - min_out(), max_out(): extreme values (zero-time tuples are ignored),
+ *  - rms_out(): root mean square,
+ *  - percentile_out(): approximate percentile of the time-weighted values.
+ * Up to the first complete window, the aggregates cover the time since zero.
+ *
+ * The input is summarised per hop ("pane").  Sliding the window adds one pane
+ * and evicts another, so the costs per tuple do not depend on the window
+ * length: the sums are updated incrementally, minimum and maximum are kept in
+ * monotonic queues.  For percentiles, a running sketch of the window adds the
+ * sketch of each new pane and subtracts the one of the evicted pane, the
+ * accuracy of the sketches is given on construction.
+ *
+ * The outputs are only committed up to the end of the last completed hop.
+ *
+ * This base class aggregates the values independently of the input type,
+ * see timed_stream_window_aggregator.
+ */
+class timed_stream_window_aggregator_base : public timed_stream_processor_base
+{
+public:
+  using base_type = timed_stream_processor_base;
+
+  using value_type = double;
+  using stream_type = timed_stream<value_type, timed_state_traits<value_type>>;
+
+  void mean_out(stream_type& stream);
+  void min_out(stream_type& stream);
+  void max_out(stream_type& stream);
+  void rms_out(stream_type& stream);
+  /// emit the \a q-quantile, \a q in [0, 1], to \a stream
+  void percentile_out(double q, stream_type& stream);
+
+  duration_type const& window() const { return window_; }
+  duration_type const& hop() const { return hop_; }
+
+protected:
+  timed_stream_window_aggregator_base(duration_type const& window,
+                                      duration_type const& hop,
+                                      double relative_accuracy);
+
+  /// aggregate the value \a v for the duration \a dur
+  void aggregate(value_type v, duration_type dur);
+
+  duration_type do_commit(duration_type until) override;
+
+private:
+  using writer_type = stream_type::writer_type;
+  using sum_type = sysx::utils::kahan_sum;
+  using sketch_type = sysx::utils::quantile_sketch;
+
+  /// summary of the input within a hop
+  struct pane
+  {
+    explicit pane(double relative_accuracy);
+    void add(value_type v, double seconds);
+
+    double weight;
+    double sum;
+    double sumsq;
+    value_type min;
+    value_type max;
+    bool valid; ///< min and max are set
+    sketch_type sketch;
+  };
+
+  /// (pane sequence number, value)
+  using extreme_type = std::pair<std::size_t, value_type>;
+
+  void close_pane();
+  void emit();
+
+  duration_type window_;
+  duration_type hop_;
+  std::size_t panes_per_window_;
+  double accuracy_;
+
+  duration_type pane_pos_;  ///< elapsed time within the current pane
+  time_type emitted_until_; ///< end of the last completed hop
+  std::size_t pane_seq_;
+
+  pane current_;
+  std::deque<pane> panes_;
+
+  sum_type weight_;
+  sum_type sum_;
+  sum_type sumsq_;
+  std::deque<extreme_type> min_;
+  std::deque<extreme_type> max_;
+  sketch_type sketch_; ///< running sketch of the panes within the window
+
+  std::shared_ptr<writer_type> mean_;
+  std::shared_ptr<writer_type> minimum_;
+  std::shared_ptr<writer_type> maximum_;
+  std::shared_ptr<writer_type> rms_;
+  std::vector<std::pair<double, std::shared_ptr<writer_type>>> percentiles_;
+};
+
+/**
+ * \brief window aggregation of a stream of type \a T with \a Traits
+ *
+ * The values are aggregated as doubles.  Values of state-like streams are
+ * aggregated as is.  The values of process streams (timed_split_policy_average)
+ * are extensive, e.g. the energy of a power trace or the work items of a
+ * queue, and aggregated as their rate, i.e. the value per second of the tuple.
+ */
+template<typename T = double, typename Traits = timed_state_traits<T>>
+class timed_stream_window_aggregator
+  : public timed_stream_window_aggregator_base
+{
+public:
+  using base_type = timed_stream_window_aggregator_base;
+  using input_type = timed_stream<T, Traits>;
+
+  explicit timed_stream_window_aggregator(
+    duration_type const& window,
+    duration_type const& hop = duration_type(),
+    double relative_accuracy = 0.01)
+    : base_type(window, hop, relative_accuracy)
+  {}
+
+  void in(input_type& stream);
+  void in(typename input_type::writer_type& writer);
+
+protected:
+  duration_type process(duration_type dur) override;
+
+private:
+  using reader_type = typename input_type::reader_type;
+
+  /// values are split proportionally to the duration
+  static const bool extensive =
+    std::is_same<typename Traits::split_policy,
+                 timed_split_policy_average<T>>::value;
+
+  std::shared_ptr<reader_type> reader_;
+};
+
+template<typename T, typename Traits>
+void
+timed_stream_window_aggregator<T, Traits>::in(input_type& stream)
+{
+  SYSX_ASSERT(!reader_ && "input already bound");
+  reader_ = timed_stream_processor_base::in(stream);
+}
+
+template<typename T, typename Traits>
+void
+timed_stream_window_aggregator<T, Traits>::in(
+  typename input_type::writer_type& writer)
+{
+  auto stream = dynamic_cast<input_type*>(&writer.stream());
+  SYSX_ASSERT(stream != nullptr);
+  in(*stream);
+}
+
+template<typename T, typename Traits>
+typename timed_stream_window_aggregator<T, Traits>::duration_type
+timed_stream_window_aggregator<T, Traits>::process(duration_type)
+{
+  auto cur = reader_->cursor();
+
+  // summarise all available tuples per pane
+  duration_type done;
+  for (; !cur.at_end(); cur.next()) {
+    auto const left = cur.remaining();
+    SYSX_ASSERT(!left.is_infinite() && "cannot aggregate infinite tuples");
+    if (left == duration_type::zero_time)
+      continue;
+
+    auto v = static_cast<value_type>(cur.value());
+    if (extensive)
+      v /= to_seconds(left);
+
+    aggregate(v, left);
+    done += left;
+  }
+
+  reader_->pop_until(cur);
+  return done;
+}
+
+} // namespace tracing
+
+#endif /* TVS_TIMED_STREAM_WINDOW_AGGREGATOR_H_INCLUDED_ */
+/* Taf!
+ */
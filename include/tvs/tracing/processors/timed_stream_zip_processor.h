@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_stream_zip_processor.h
+ * \brief  processor combining heterogeneous input streams
+ * \see    timed_stream_processor_base.h
+ */
+
+#ifndef TVS_TIMED_STREAM_ZIP_PROCESSOR_H_INCLUDED_
+#define TVS_TIMED_STREAM_ZIP_PROCESSOR_H_INCLUDED_
+
+#include <tvs/tracing/processors/timed_stream_processor_base.h>
+
+#include <tvs/tracing/timed_reader.h>
+#include <tvs/tracing/timed_stream.h>
+#include <tvs/tracing/timed_writer.h>
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tracing {
+
+namespace impl {
+
+template<bool...>
+struct bool_pack;
+
+/// are all given conditions true?
+template<bool... B>
+using all_of = std::is_same<bool_pack<true, B...>, bool_pack<B..., true>>;
+
+} // namespace impl
+
+/**
+ * \brief processor applying a function to aligned segments of its inputs
+ *
+ * \tparam F the function, called as \c F(In::value_type const&...)
+ * \tparam Out the output stream type, the result of \a F is converted to its
+ *         value_type
+ * \tparam In the input stream types
+ *
+ * The inputs are split into segments at the tuple boundaries of all inputs,
+ * each segment is read according to the split policy of the respective input.
+ * The result of \a F is pushed to the output for the duration of the segment.
+ *
+ * In contrast to timed_stream_binop_processor, the readers are kept with
+ * their concrete types and all tuples available on all inputs are processed
+ * at once without calling virtual functions per tuple.  If all values are
+ * arithmetic, the values of the segments are gathered into contiguous arrays
+ * first, so that the loop calling \a F can be vectorised.
+ *
+ * \see make_zip_processor()
+ */
+template<typename F, typename Out, typename... In>
+class timed_zip_processor : public timed_stream_processor_base
+{
+  static_assert(sizeof...(In) > 0, "at least one input is required");
+
+public:
+  using base_type = timed_stream_processor_base;
+  using function_type = F;
+  using output_stream_type = Out;
+  using writer_type = typename Out::writer_type;
+  using result_type = typename Out::value_type;
+
+  /// are the segments processed in batches?
+  static const bool batched =
+    impl::all_of<std::is_arithmetic<result_type>::value,
+                 std::is_arithmetic<typename In::value_type>::value...>::value;
+
+  timed_zip_processor(F f, Out& out, In&... in)
+    : f_(std::move(f))
+    , readers_{ base_type::in(in)... }
+    , writer_(base_type::out(out))
+  {}
+
+protected:
+  duration_type process(duration_type) override
+  {
+    return run(std::index_sequence_for<In...>());
+  }
+
+private:
+  typedef std::tuple<std::shared_ptr<typename In::reader_type>...>
+    readers_type;
+  typedef std::tuple<std::vector<typename In::value_type>...> batch_type;
+  typedef int swallow[];
+
+  /// process all segments available on all inputs
+  template<std::size_t... I>
+  duration_type run(std::index_sequence<I...> idx)
+  {
+    auto cur = std::make_tuple(std::get<I>(readers_)->cursor()...);
+
+    duration_type done;
+    for (;;) {
+      bool at_end = false;
+      (void)swallow{ 0, (at_end |= std::get<I>(cur).at_end(), 0)... };
+      if (at_end)
+        break;
+
+      auto seg = std::min({ std::get<I>(cur).remaining()... });
+      emit(seg,
+           std::integral_constant<bool, batched>(),
+           std::get<I>(cur).tuple(seg).value()...);
+
+      (void)swallow{ 0, (std::get<I>(cur).advance_segment(seg), 0)... };
+      done += seg;
+    }
+    flush(idx, std::integral_constant<bool, batched>());
+
+    // consume the processed tuples
+    (void)swallow{ 0,
+                   (std::get<I>(readers_)->pop_until(std::get<I>(cur)), 0)... };
+    return done;
+  }
+
+  template<typename... Values>
+  void emit(duration_type const& seg, std::false_type, Values const&... v)
+  {
+    writer_->push(f_(v...), seg);
+  }
+
+  template<typename... Values>
+  void emit(duration_type const& seg, std::true_type, Values const&... v)
+  {
+    gather(std::index_sequence_for<In...>(), v...);
+    durations_.push_back(seg);
+  }
+
+  template<std::size_t... I, typename... Values>
+  void gather(std::index_sequence<I...>, Values const&... v)
+  {
+    (void)swallow{ 0, (std::get<I>(batch_).push_back(v), 0)... };
+  }
+
+  template<std::size_t... I>
+  void flush(std::index_sequence<I...>, std::false_type)
+  {}
+
+  template<std::size_t... I>
+  void flush(std::index_sequence<I...>, std::true_type)
+  {
+    auto const n = durations_.size();
+    results_.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+      results_[i] = f_(std::get<I>(batch_)[i]...);
+
+    for (std::size_t i = 0; i < n; ++i)
+      writer_->push(results_[i], durations_[i]);
+
+    durations_.clear();
+    (void)swallow{ 0, (std::get<I>(batch_).clear(), 0)... };
+  }
+
+  F f_;
+  readers_type readers_;
+  std::shared_ptr<writer_type> writer_;
+
+  batch_type batch_;
+  std::vector<duration_type> durations_;
+  std::vector<result_type> results_;
+};
+
+template<typename F, typename Out, typename... In>
+const bool timed_zip_processor<F, Out, In...>::batched;
+
+/// create a timed_zip_processor writing \a f(in...) to \a out
+template<typename F, typename Out, typename... In>
+std::unique_ptr<timed_zip_processor<F, Out, In...>>
+make_zip_processor(F f, Out& out, In&... in)
+{
+  return std::unique_ptr<timed_zip_processor<F, Out, In...>>(
+    new timed_zip_processor<F, Out, In...>(std::move(f), out, in...));
+}
+
+} // namespace tracing
+
+#endif /* TVS_TIMED_STREAM_ZIP_PROCESSOR_H_INCLUDED_ */
+/* Taf!
+ */
@@ -37,13 +37,14 @@ public:
   virtual ~vcd_event_converter_base() = default;
 };
 
-// convert between std::set<T> to T streams for vcd sink
-template<typename T>
+// convert between event set streams and T streams for vcd sink
+template<typename Set>
 class vcd_event_converter
   : public tracing::timed_listener_if
   , public vcd_event_converter_base
 {
-  using input_stream_type = event_stream_type<T>;
+  using T = typename Set::value_type;
+  using input_stream_type = event_stream_type<T, Set>;
   using output_stream_type =
     tracing::timed_stream<T, tracing::timed_state_traits<T>>;
 
@@ -68,13 +69,19 @@ public:
     return static_cast<output_stream_type&>(output_.stream());
   }
 
+  void collect_downstream(
+    std::vector<tracing::timed_stream_base*>& streams) const final
+  {
+    streams.push_back(&const_cast<writer_type&>(output_).stream());
+  }
+
 private:
   void notify(tracing::timed_reader_base&) final
   {
     while (input_.available()) {
       typename writer_type::tuple_type tup;
-      auto elems = input_.get();
-      if (!input_.empty()) {
+      auto const& elems = input_.get();
+      if (!elems.empty()) {
         // take first element
         tup.value(*elems.begin());
       }
@@ -92,11 +99,11 @@ private:
   writer_type output_;
 };
 
-template<typename T>
-std::unique_ptr<vcd_event_converter<T>>
-create_converter(event_stream_type<T>& input)
+template<typename Set>
+std::unique_ptr<vcd_event_converter<Set>>
+create_converter(timed_stream<Set, timed_event_traits<Set>>& input)
 {
-  return std::make_unique<vcd_event_converter<T>>(input);
+  return std::make_unique<vcd_event_converter<Set>>(input);
 }
 
 } // namespace impl
@@ -0,0 +1,615 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_compressed_sequence.h
+ * \brief  compressed sequence of double-valued timed values
+ * \see    timed_packed_sequence.h
+ *
+ * A \ref timed_compressed_sequence archives long \c double streams (e.g. power
+ * traces) in sealed blocks, which are encoded similar to the Gorilla time
+ * series format: values are stored as the XOR to their predecessor and
+ * durations as the difference to the previous duration.  Slowly changing
+ * values with repeating durations need only a few bits per tuple.
+ *
+ * Like \ref timed_packed_sequence, it is an archive for committed tuples,
+ * which \ref timed_compressed_recorder drains from a stream, and not a buffer
+ * format of the streams and readers: those split, join and erase tuples in
+ * place through timed_range and the deque iterators of \ref timed_sequence.
+ */
+
+#ifndef TVS_TIMED_COMPRESSED_SEQUENCE_H_INCLUDED_
+#define TVS_TIMED_COMPRESSED_SEQUENCE_H_INCLUDED_
+
+#include <tvs/tracing/timed_packed_sequence.h> // impl::packed_ticks
+#include <tvs/tracing/timed_recorder.h>
+#include <tvs/tracing/timed_stream_traits.h>
+
+#include <tvs/utils/assert.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace tracing {
+
+namespace impl {
+
+/// append-only bit stream
+class gorilla_bits
+{
+public:
+  typedef std::uint64_t word_type;
+
+  gorilla_bits()
+    : words_()
+    , bits_()
+  {}
+
+  void write(word_type v, unsigned n)
+  {
+    if (n == 0)
+      return;
+    if (n < 64)
+      v &= (word_type(1) << n) - 1;
+
+    unsigned offset = bits_ % 64;
+    if (offset == 0)
+      words_.push_back(0);
+    words_.back() |= v << offset;
+    if (offset + n > 64) // spill into the next word
+      words_.push_back(v >> (64 - offset));
+    bits_ += n;
+  }
+
+  word_type read(std::size_t& pos, unsigned n) const
+  {
+    if (n == 0)
+      return 0;
+    std::size_t idx = pos / 64;
+    unsigned offset = pos % 64;
+    word_type v = words_[idx] >> offset;
+    if (offset + n > 64)
+      v |= words_[idx + 1] << (64 - offset);
+    if (n < 64)
+      v &= (word_type(1) << n) - 1;
+    pos += n;
+    return v;
+  }
+
+  std::size_t bytes() const { return words_.capacity() * sizeof(word_type); }
+
+  void shrink() { words_.shrink_to_fit(); }
+
+private:
+  std::vector<word_type> words_;
+  std::size_t bits_;
+};
+
+/// encoder/decoder state of a block
+struct gorilla_state
+{
+  typedef std::uint64_t word_type;
+  typedef std::int64_t delta_type;
+
+  gorilla_state()
+    : value()
+    , ticks()
+    , lead(~0u)
+    , trail()
+    , first(true)
+  {}
+
+  word_type value;
+  word_type ticks;
+  unsigned lead;
+  unsigned trail;
+  bool first;
+
+  static unsigned leading_zeros(word_type x)
+  {
+    unsigned n = 0;
+    for (word_type mask = word_type(1) << 63; !(x & mask); mask >>= 1)
+      ++n;
+    return n;
+  }
+
+  static unsigned trailing_zeros(word_type x)
+  {
+    unsigned n = 0;
+    for (; !(x & 1); x >>= 1)
+      ++n;
+    return n;
+  }
+
+  void encode(gorilla_bits& out, word_type v, word_type t)
+  {
+    if (first) {
+      out.write(v, 64);
+      out.write(t, 64);
+      first = false;
+      value = v;
+      ticks = t;
+      return;
+    }
+
+    // durations: difference to the previous duration
+    auto delta = static_cast<delta_type>(t - ticks);
+    if (delta == 0) {
+      out.write(0x0, 1);
+    } else if (delta >= -64 && delta <= 63) {
+      out.write(0x1, 2); // '10'
+      out.write(static_cast<word_type>(delta), 7);
+    } else if (delta >= -256 && delta <= 255) {
+      out.write(0x3, 3); // '110'
+      out.write(static_cast<word_type>(delta), 9);
+    } else if (delta >= -2048 && delta <= 2047) {
+      out.write(0x7, 4); // '1110'
+      out.write(static_cast<word_type>(delta), 12);
+    } else {
+      out.write(0xf, 4); // '1111'
+      out.write(static_cast<word_type>(delta), 64);
+    }
+    ticks = t;
+
+    // values: XOR to the previous value
+    word_type x = v ^ value;
+    value = v;
+    if (x == 0) {
+      out.write(0x0, 1);
+      return;
+    }
+    unsigned lz = std::min(leading_zeros(x), 31u);
+    unsigned tz = trailing_zeros(x);
+    if (lead != ~0u && lz >= lead && tz >= trail) {
+      out.write(0x1, 2); // '10': reuse the previous window
+      out.write(x >> trail, 64 - lead - trail);
+      return;
+    }
+    lead = lz;
+    trail = tz;
+    unsigned len = 64 - lz - tz;
+    out.write(0x3, 2); // '11': new window
+    out.write(lz, 5);
+    out.write(len - 1, 6);
+    out.write(x >> tz, len);
+  }
+
+  void decode(gorilla_bits const& in, std::size_t& pos)
+  {
+    if (first) {
+      value = in.read(pos, 64);
+      ticks = in.read(pos, 64);
+      first = false;
+      return;
+    }
+
+    if (in.read(pos, 1)) {
+      unsigned n;
+      if (!in.read(pos, 1))
+        n = 7;
+      else if (!in.read(pos, 1))
+        n = 9;
+      else if (!in.read(pos, 1))
+        n = 12;
+      else
+        n = 64;
+      ticks += sign_extend(in.read(pos, n), n);
+    }
+
+    if (in.read(pos, 1)) {
+      if (in.read(pos, 1)) {
+        lead = static_cast<unsigned>(in.read(pos, 5));
+        unsigned len = static_cast<unsigned>(in.read(pos, 6)) + 1;
+        trail = 64 - lead - len;
+      }
+      value ^= in.read(pos, 64 - lead - trail) << trail;
+    }
+  }
+
+  static word_type sign_extend(word_type v, unsigned n)
+  {
+    if (n < 64 && (v & (word_type(1) << (n - 1))))
+      v |= ~word_type(0) << n;
+    return v;
+  }
+};
+
+} // namespace impl
+
+/**
+ * \brief compressed, append-only sequence of double values
+ *
+ * Tuples are collected in an open block, which is sealed and compressed once
+ * it holds \c block_size tuples.  Each sealed block keeps the sum, minimum
+ * and maximum of its values, so that these aggregates are computed without
+ * decoding fully available blocks.  Consumed tuples are removed with
+ * pop_front(), a sealed block is released once it has been consumed.
+ *
+ * Values are stored losslessly, durations are quantised to integral time
+ * ticks (cf. timed_packed_sequence).
+ */
+template<typename Traits = timed_process_traits<double>>
+class timed_compressed_sequence : public timed_sequence_base
+{
+  typedef impl::packed_ticks ticks;
+  typedef impl::gorilla_state state_type;
+  typedef state_type::word_type word_type;
+
+  static_assert(sizeof(double) == sizeof(word_type), "unsupported double");
+
+public:
+  typedef timed_sequence_base base_type;
+  typedef timed_compressed_sequence this_type;
+  typedef base_type::duration_type duration_type;
+
+  typedef double value_type;
+  typedef Traits traits_type;
+  typedef timed_value<value_type> tuple_type;
+  typedef typename traits_type::join_policy join_policy;
+  typedef std::size_t size_type;
+
+  /// number of tuples per sealed block
+  static const size_type block_size = 256;
+
+private:
+  struct block
+  {
+    impl::gorilla_bits bits;
+    size_type count;
+    value_type sum;
+    value_type min;
+    value_type max;
+  };
+
+  /// sequential decoder of a sealed block
+  struct decoder
+  {
+    decoder()
+      : blk()
+      , pos()
+      , idx()
+      , state()
+    {}
+
+    explicit decoder(block const& b)
+      : blk(&b)
+      , pos()
+      , idx()
+      , state()
+    {}
+
+    bool done() const { return idx == blk->count; }
+
+    tuple_type next()
+    {
+      state.decode(blk->bits, pos);
+      ++idx;
+      return tuple_type(to_value(state.value), ticks::from_ticks(state.ticks));
+    }
+
+    block const* blk;
+    std::size_t pos;
+    size_type idx;
+    state_type state;
+  };
+
+public:
+  /// forward iterator decoding proxy tuples
+  class const_iterator
+  {
+    friend class timed_compressed_sequence;
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef tuple_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef tuple_type const* pointer;
+    typedef tuple_type const& reference;
+
+    const_iterator()
+      : seq_()
+      , blk_()
+      , open_()
+    {}
+
+    reference operator*() const { return cur_; }
+    pointer operator->() const { return &cur_; }
+
+    const_iterator& operator++()
+    {
+      advance();
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    friend bool operator==(const_iterator const& a, const_iterator const& b)
+    {
+      return a.equal(b);
+    }
+    friend bool operator!=(const_iterator const& a, const_iterator const& b)
+    {
+      return !(a == b);
+    }
+
+  private:
+    bool equal(const_iterator const& that) const
+    {
+      return blk_ == that.blk_ && open_ == that.open_ &&
+             (blk_ == seq_->sealed_.size() || dec_.idx == that.dec_.idx);
+    }
+
+    // begin
+    explicit const_iterator(this_type const* seq)
+      : seq_(seq)
+      , blk_()
+      , open_()
+      , dec_(seq->head_)
+    {
+      if (seq_->sealed_.empty())
+        open_ = seq_->open_head_;
+      advance();
+    }
+
+    // end
+    const_iterator(this_type const* seq, size_type open)
+      : seq_(seq)
+      , blk_(seq->sealed_.size())
+      , open_(open + 1)
+    {}
+
+    void advance()
+    {
+      while (blk_ < seq_->sealed_.size()) {
+        if (!dec_.done()) {
+          cur_ = dec_.next();
+          return;
+        }
+        if (++blk_ < seq_->sealed_.size())
+          dec_ = decoder(seq_->sealed_[blk_]);
+        else
+          open_ = seq_->open_head_;
+      }
+      if (open_ < seq_->open_.size())
+        cur_ = seq_->open_[open_];
+      ++open_;
+    }
+
+    this_type const* seq_;
+    size_type blk_;
+    size_type open_; ///< index of the next tuple in the open block
+    decoder dec_;
+    tuple_type cur_;
+  };
+
+  timed_compressed_sequence()
+    : base_type()
+    , sealed_()
+    , head_()
+    , open_()
+    , open_head_()
+    , size_()
+  {}
+
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  /// number of sealed (compressed) blocks
+  size_type blocks() const { return sealed_.size(); }
+
+  /** \name append to the sequence */
+  ///\{
+  void push_back(value_type const& v, duration_type const& d)
+  {
+    push_back(tuple_type(v, d));
+  }
+
+  void push_back(tuple_type const& t, bool join = true)
+  {
+    SYSX_ASSERT(open_.empty() || !open_.back().is_infinite());
+
+    add_duration(t.duration());
+    if (open_.size() > open_head_ && join &&
+        join_policy::join(open_.back(), t))
+      return;
+
+    open_.push_back(t);
+    ++size_;
+    if (open_.size() == block_size && !t.is_infinite())
+      seal();
+  }
+
+  template<typename InputIterator>
+  void push_back(InputIterator from, InputIterator to)
+  {
+    while (from != to)
+      push_back(*from++);
+  }
+
+  template<typename SequenceType>
+  void push_back(SequenceType const& seq)
+  {
+    push_back(seq.begin(), seq.end());
+  }
+  ///\}
+
+  /** \name access and consume the head of the sequence */
+  ///\{
+  tuple_type front() const
+  {
+    SYSX_ASSERT(!empty());
+    return *begin();
+  }
+
+  duration_type front_duration() const { return front().duration(); }
+
+  void pop_front()
+  {
+    SYSX_ASSERT(!empty());
+    del_duration(front_duration());
+    --size_;
+
+    if (sealed_.empty()) {
+      if (++open_head_ == open_.size()) {
+        open_.clear();
+        open_head_ = 0;
+      }
+      return;
+    }
+
+    head_.next();
+    if (head_.done()) {
+      sealed_.pop_front();
+      head_ = sealed_.empty() ? decoder() : decoder(sealed_.front());
+    }
+  }
+  ///\}
+
+  /** \name const tuple iterators */
+  ///\{
+  const_iterator begin() const { return const_iterator(this); }
+  const_iterator end() const { return const_iterator(this, open_.size()); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  ///\}
+
+  /** \name aggregates (empty sequence: 0, +inf, -inf) */
+  ///\{
+  value_type sum() const
+  {
+    value_type ret = 0;
+    aggregate([&](block const& b) { ret += b.sum; },
+              [&](value_type v) { ret += v; });
+    return ret;
+  }
+
+  value_type min() const
+  {
+    value_type ret = std::numeric_limits<value_type>::infinity();
+    aggregate([&](block const& b) { ret = std::min(ret, b.min); },
+              [&](value_type v) { ret = std::min(ret, v); });
+    return ret;
+  }
+
+  value_type max() const
+  {
+    value_type ret = -std::numeric_limits<value_type>::infinity();
+    aggregate([&](block const& b) { ret = std::max(ret, b.max); },
+              [&](value_type v) { ret = std::max(ret, v); });
+    return ret;
+  }
+  ///\}
+
+  /// approximate number of allocated bytes
+  size_type memory_usage() const
+  {
+    size_type ret = sizeof(*this) + open_.size() * sizeof(tuple_type);
+    for (auto const& b : sealed_)
+      ret += sizeof(block) + b.bits.bytes();
+    return ret;
+  }
+
+private:
+  static word_type to_bits(value_type v)
+  {
+    word_type w;
+    std::memcpy(&w, &v, sizeof(w));
+    return w;
+  }
+
+  static value_type to_value(word_type w)
+  {
+    value_type v;
+    std::memcpy(&v, &w, sizeof(v));
+    return v;
+  }
+
+  void seal()
+  {
+    open_.erase(open_.begin(), open_.begin() + open_head_);
+    open_head_ = 0;
+
+    block b;
+    b.count = open_.size();
+    b.sum = 0;
+    b.min = std::numeric_limits<value_type>::infinity();
+    b.max = -b.min;
+
+    state_type enc;
+    for (auto const& t : open_) {
+      enc.encode(b.bits, to_bits(t.value()), ticks::to_ticks(t.duration()));
+      b.sum += t.value();
+      b.min = std::min(b.min, t.value());
+      b.max = std::max(b.max, t.value());
+    }
+    b.bits.shrink();
+    open_.clear();
+
+    sealed_.push_back(std::move(b));
+    if (sealed_.size() == 1)
+      head_ = decoder(sealed_.front());
+  }
+
+  // apply the block aggregate to fully available blocks and the value
+  // function to all other tuples
+  template<typename BlockFunc, typename ValueFunc>
+  void aggregate(BlockFunc block_func, ValueFunc value_func) const
+  {
+    auto it = sealed_.begin();
+    if (it != sealed_.end() && head_.idx > 0) {
+      auto dec = head_;
+      while (!dec.done())
+        value_func(dec.next().value());
+      ++it;
+    }
+    for (; it != sealed_.end(); ++it)
+      block_func(*it);
+    for (size_type i = open_head_; i < open_.size(); ++i)
+      value_func(open_[i].value());
+  }
+
+  std::deque<block> sealed_;
+  decoder head_;            ///< decoder positioned at the front tuple
+  std::vector<tuple_type> open_;
+  size_type open_head_;     ///< consumed tuples of the open block
+  size_type size_;
+}; // timed_compressed_sequence
+
+template<typename Traits>
+const typename timed_compressed_sequence<Traits>::size_type
+  timed_compressed_sequence<Traits>::block_size;
+
+/// record a double stream into a compressed sequence (see timed_recorder)
+template<typename Traits = timed_process_traits<double>>
+using timed_compressed_recorder =
+  timed_recorder<timed_compressed_sequence<Traits>>;
+
+} // namespace tracing
+
+#endif /* TVS_TIMED_COMPRESSED_SEQUENCE_H_INCLUDED_ */
+/* Taf!
+ */
@@ -247,6 +247,13 @@ SYSX_TIMED_DURATION_RELOP_(!=)
 SYSX_TIMED_DURATION_SCALAR_OP_(*)
 SYSX_TIMED_DURATION_SCALAR_OP_(/)
 
+/// duration in seconds, e.g. for weighting values by time
+inline double
+to_seconds(timed_duration const& d)
+{
+  return timed_duration::units_type(d).value();
+}
+
 /* --------------------------------------------------------------------- */
 
 #undef SYSX_TIMED_DURATION_BINOP_
@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_event_sets.h
+ * \brief  compact set types for event streams
+ * \see    timed_event_writer.h
+ *
+ * Event streams hold a set of events per tuple.  Besides \c std::set, the
+ * following set types can be used with \ref timed_event_writer and the
+ * event traits:
+ *
+ *  - \ref small_event_set: sorted flat set with inline storage for a few
+ *    elements, which avoids heap allocations for the common case of a single
+ *    event per tuple
+ *  - \ref bitmask_event_set: set of enumerators (or small integers) with
+ *    values below 64, represented as a single 64-bit mask
+ */
+
+#ifndef TVS_TIMED_EVENT_SETS_H_INCLUDED_
+#define TVS_TIMED_EVENT_SETS_H_INCLUDED_
+
+#include <tvs/tracing/timed_stream_policies.h>
+#include <tvs/tracing/timed_value.h>
+#include <tvs/utils/assert.h>
+#include <tvs/utils/variant_traits.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tracing {
+
+/* -------------------------- small_event_set -------------------------- */
+
+/**
+ * \brief sorted set with inline storage for up to \a N elements
+ *
+ * Larger sets move their elements to the heap.  Iterators are plain pointers
+ * and are invalidated by any insertion.
+ */
+template<typename T, std::size_t N = 4>
+class small_event_set
+{
+public:
+  typedef T value_type;
+  typedef T key_type;
+  typedef std::size_t size_type;
+  typedef T const* const_iterator;
+  typedef const_iterator iterator;
+  typedef T const& const_reference;
+  typedef const_reference reference;
+
+  small_event_set()
+    : size_()
+    , inline_()
+    , heap_()
+  {}
+
+  small_event_set(std::initializer_list<T> init)
+    : small_event_set()
+  {
+    insert(init.begin(), init.end());
+  }
+
+  template<typename InputIterator>
+  small_event_set(InputIterator from, InputIterator to)
+    : small_event_set()
+  {
+    insert(from, to);
+  }
+
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + size_; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_type count(T const& v) const { return find(v) != end(); }
+
+  const_iterator find(T const& v) const
+  {
+    auto it = std::lower_bound(begin(), end(), v);
+    return (it != end() && !(v < *it)) ? it : end();
+  }
+
+  void clear()
+  {
+    size_ = 0;
+    heap_.clear();
+  }
+
+  std::pair<iterator, bool> insert(T const& v)
+  {
+    auto pos = std::lower_bound(begin(), end(), v);
+    if (pos != end() && !(v < *pos))
+      return std::make_pair(pos, false);
+
+    auto idx = static_cast<size_type>(pos - begin());
+    if (size_ < N && heap_.empty()) {
+      auto first = inline_.begin() + idx, last = inline_.begin() + size_;
+      std::move_backward(first, last, last + 1);
+      inline_[idx] = v;
+    } else {
+      if (heap_.empty())
+        heap_.assign(inline_.begin(), inline_.begin() + size_);
+      heap_.insert(heap_.begin() + idx, v);
+    }
+    ++size_;
+    return std::make_pair(begin() + idx, true);
+  }
+
+  template<typename InputIterator>
+  void insert(InputIterator from, InputIterator to)
+  {
+    while (from != to)
+      insert(*from++);
+  }
+
+  /// union with another set (linear merge of the sorted elements)
+  void merge(small_event_set const& that)
+  {
+    if (that.empty())
+      return;
+    if (empty()) {
+      *this = that;
+      return;
+    }
+
+    std::vector<T> result;
+    result.reserve(size_ + that.size_);
+    std::set_union(begin(), end(), that.begin(), that.end(),
+                   std::back_inserter(result));
+
+    size_ = result.size();
+    if (size_ <= N) {
+      std::copy(result.begin(), result.end(), inline_.begin());
+      heap_.clear();
+    } else {
+      heap_.swap(result);
+    }
+  }
+
+  void swap(small_event_set& that)
+  {
+    std::swap(size_, that.size_);
+    std::swap(inline_, that.inline_);
+    heap_.swap(that.heap_);
+  }
+
+  friend bool operator==(small_event_set const& a, small_event_set const& b)
+  {
+    return a.size_ == b.size_ && std::equal(a.begin(), a.end(), b.begin());
+  }
+  friend bool operator!=(small_event_set const& a, small_event_set const& b)
+  {
+    return !(a == b);
+  }
+  friend bool operator<(small_event_set const& a, small_event_set const& b)
+  {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(),
+                                        b.end());
+  }
+
+private:
+  T const* data() const
+  {
+    return heap_.empty() ? inline_.data() : heap_.data();
+  }
+
+  size_type size_;
+  std::array<T, N> inline_;
+  std::vector<T> heap_;
+};
+
+/* ------------------------- bitmask_event_set ------------------------- */
+
+/**
+ * \brief set of enumerators (or small integers) with values in [0,64)
+ */
+template<typename E>
+class bitmask_event_set
+{
+  static_assert(std::is_enum<E>::value || std::is_integral<E>::value,
+                "bitmask_event_set requires an enumeration or integral type");
+
+public:
+  typedef E value_type;
+  typedef E key_type;
+  typedef std::size_t size_type;
+  typedef std::uint64_t mask_type;
+
+  /// forward iterator over the set bits
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef E value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef E const* pointer;
+    typedef E reference;
+
+    explicit const_iterator(mask_type rest = 0)
+      : rest_(rest)
+    {}
+
+    E operator*() const { return static_cast<E>(lowest(rest_)); }
+
+    const_iterator& operator++()
+    {
+      rest_ &= rest_ - 1;
+      return *this;
+    }
+    const_iterator operator++(int)
+    {
+      const_iterator ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    friend bool operator==(const_iterator a, const_iterator b)
+    {
+      return a.rest_ == b.rest_;
+    }
+    friend bool operator!=(const_iterator a, const_iterator b)
+    {
+      return a.rest_ != b.rest_;
+    }
+
+  private:
+    mask_type rest_;
+  };
+  typedef const_iterator iterator;
+
+  bitmask_event_set()
+    : mask_()
+  {}
+
+  bitmask_event_set(std::initializer_list<E> init)
+    : mask_()
+  {
+    insert(init.begin(), init.end());
+  }
+
+  template<typename InputIterator>
+  bitmask_event_set(InputIterator from, InputIterator to)
+    : mask_()
+  {
+    insert(from, to);
+  }
+
+  const_iterator begin() const { return const_iterator(mask_); }
+  const_iterator end() const { return const_iterator(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  size_type size() const
+  {
+    size_type n = 0;
+    for (mask_type m = mask_; m; m &= m - 1)
+      ++n;
+    return n;
+  }
+  bool empty() const { return mask_ == 0; }
+  size_type count(E v) const { return (mask_ & bit(v)) ? 1 : 0; }
+  const_iterator find(E v) const
+  {
+    return count(v) ? const_iterator(mask_ & ~(bit(v) - 1)) : end();
+  }
+
+  mask_type mask() const { return mask_; }
+
+  void clear() { mask_ = 0; }
+
+  std::pair<iterator, bool> insert(E v)
+  {
+    bool inserted = !count(v);
+    mask_ |= bit(v);
+    return std::make_pair(find(v), inserted);
+  }
+
+  template<typename InputIterator>
+  void insert(InputIterator from, InputIterator to)
+  {
+    while (from != to)
+      mask_ |= bit(*from++);
+  }
+
+  /// union with another set
+  void merge(bitmask_event_set const& that) { mask_ |= that.mask_; }
+
+  void swap(bitmask_event_set& that) { std::swap(mask_, that.mask_); }
+
+  friend bool operator==(bitmask_event_set a, bitmask_event_set b)
+  {
+    return a.mask_ == b.mask_;
+  }
+  friend bool operator!=(bitmask_event_set a, bitmask_event_set b)
+  {
+    return a.mask_ != b.mask_;
+  }
+  friend bool operator<(bitmask_event_set a, bitmask_event_set b)
+  {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(),
+                                        b.end());
+  }
+
+private:
+  static mask_type bit(E v)
+  {
+    auto idx = static_cast<long long>(v);
+    SYSX_ASSERT(idx >= 0 && idx < 64 && "event value out of bitmask range");
+    return mask_type(1) << idx;
+  }
+
+  static unsigned lowest(mask_type m)
+  {
+    unsigned idx = 0;
+    while (!(m & 1)) {
+      m >>= 1;
+      ++idx;
+    }
+    return idx;
+  }
+
+  mask_type mask_;
+};
+
+/* ---------------------------- set detection -------------------------- */
+
+/// is \a S a set type usable for event streams?
+template<typename S>
+struct is_event_set : std::false_type
+{};
+
+template<typename T, typename C, typename A>
+struct is_event_set<std::set<T, C, A>> : std::true_type
+{};
+
+template<typename T, std::size_t N>
+struct is_event_set<small_event_set<T, N>> : std::true_type
+{};
+
+template<typename E>
+struct is_event_set<bitmask_event_set<E>> : std::true_type
+{};
+
+/* ------------------------- policy specialisations -------------------- */
+
+template<typename T, std::size_t N>
+struct timed_merge_policy_union<small_event_set<T, N>>
+{
+  typedef small_event_set<T, N> value_type;
+  typedef timed_value<value_type> tuple_type;
+
+  static void merge(tuple_type& back, tuple_type const& other)
+  {
+    SYSX_ASSERT(back.duration() == other.duration());
+    back.value().merge(other.value());
+  }
+};
+
+template<typename E>
+struct timed_merge_policy_union<bitmask_event_set<E>>
+{
+  typedef bitmask_event_set<E> value_type;
+  typedef timed_value<value_type> tuple_type;
+
+  static void merge(tuple_type& back, tuple_type const& other)
+  {
+    SYSX_ASSERT(back.duration() == other.duration());
+    back.value().merge(other.value());
+  }
+};
+
+/* ------------------------------- output ------------------------------ */
+
+namespace impl {
+
+template<typename Set>
+std::ostream&
+print_event_set(std::ostream& out, Set const& s)
+{
+  if (s.empty())
+    return out << "{ - }";
+
+  out << "{ ";
+  for (auto it = s.begin(); it != s.end(); ++it) {
+    if (it != s.begin())
+      out << ", ";
+    out << *it;
+  }
+  return out << " }";
+}
+
+} // namespace impl
+
+template<typename T, std::size_t N>
+std::ostream&
+operator<<(std::ostream& out, small_event_set<T, N> const& s)
+{
+  return impl::print_event_set(out, s);
+}
+
+template<typename E>
+std::ostream&
+operator<<(std::ostream& out, bitmask_event_set<E> const& s)
+{
+  return impl::print_event_set(out, s);
+}
+
+} // namespace tracing
+
+namespace sysx {
+namespace utils {
+
+/// variant conversion of event sets (as lists, cf. std::set)
+template<typename Set>
+struct variant_traits_event_set
+{
+  typedef Set type;
+  typedef typename Set::value_type value_type;
+
+  static bool pack(variant::reference dst, type const& src)
+  {
+    variant_list ret;
+    ret.reserve(src.size());
+
+    for (auto&& i : src)
+      ret.push_back(i);
+    ret.swap(dst.set_list());
+    return true;
+  }
+  static bool unpack(type& dst, variant::const_reference src)
+  {
+    if (!src.is_list())
+      return false;
+
+    variant::const_list_reference lst = src.get_list();
+    type ret;
+    value_type cur;
+    size_t i = 0;
+    for (; i < lst.size() && lst[i].try_get(cur); ++i)
+      ret.insert(cur);
+
+    return (i == lst.size()) ? (dst.swap(ret), true) : false;
+  }
+};
+
+template<typename T, std::size_t N>
+struct variant_traits<tracing::small_event_set<T, N>>
+  : variant_traits_event_set<tracing::small_event_set<T, N>>
+{};
+
+template<typename E>
+struct variant_traits<tracing::bitmask_event_set<E>>
+  : variant_traits_event_set<tracing::bitmask_event_set<E>>
+{};
+
+} // namespace utils
+} // namespace sysx
+
+#endif /* TVS_TIMED_EVENT_SETS_H_INCLUDED_ */
+/* Taf!
+ */
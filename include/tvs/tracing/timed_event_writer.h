@@ -27,6 +27,7 @@
 
 #include <tvs/tracing/timed_writer.h>
 
+#include <tvs/tracing/timed_event_sets.h>
 #include <tvs/tracing/timed_stream_traits.h>
 
 #include <set>
@@ -36,20 +37,23 @@ namespace tracing {
 template<typename T>
 using event_set_type = std::set<T, std::less<T>, std::allocator<T>>;
 
-template<typename T>
+template<typename T, typename Set = event_set_type<T>>
 using event_stream_type =
-  tracing::timed_stream<event_set_type<T>,
-                        tracing::timed_event_traits<event_set_type<T>>>;
+  tracing::timed_stream<Set, tracing::timed_event_traits<Set>>;
 
-/// Timed-Value Stream writer interface for events implemented as std::set<T>.
-template<typename T>
+/// Timed-Value Stream writer interface for events.
+///
+/// The events of a tuple are held in a std::set<T> by default, see
+/// timed_event_sets.h for more compact alternatives.
+template<typename T, typename Set = event_set_type<T>>
 class timed_event_writer : public timed_base
 {
+  static_assert(is_event_set<Set>::value, "unsupported event set type");
 
 public:
-  using value_type = std::set<T>;
+  using value_type = Set;
 
-  using stream_type = event_stream_type<T>;
+  using stream_type = event_stream_type<T, Set>;
   using writer_type = typename stream_type::writer_type;
   using tuple_type = typename stream_type::tuple_type;
 
@@ -29,6 +29,8 @@
 #include <tvs/utils/noncopyable.h>
 
 #include <functional>
+#include <string>
+#include <vector>
 
 namespace tracing {
 
@@ -42,6 +44,14 @@ using sync_fn_type = std::function<void(time_type const&)>;
 
 void for_each_stream_in_scope(cb_type);
 
+/// Add a stream to the cached stream list of its parent scope.
+void
+register_stream(timed_stream_base* stream);
+
+/// Remove a stream from the cached stream list of its parent scope.
+void
+unregister_stream(timed_stream_base* stream);
+
 /// Synchronise with the simulation/implementation model time and the
 /// configured sync function.
 void
@@ -61,9 +71,66 @@ current_object_name();
 /// Register a synchronisation function to be called for synchronising the time
 /// with a simulation model.  This defaults to sc_core::wait(time_type) iff
 /// SystemC support is available.
+///
+/// The function is called once per host::sync_with_model().  An empty function
+/// resets the registration.
 void
 register_sync(host::sync_fn_type fn);
 
+/// Register a function to let the consumers catch up, while readers with
+/// buffer_policy::block exceed their limit after host::sync_with_model().
+///
+/// The function is called with the time of the synchronisation, up to a small
+/// number of times as long as the blocking readers make progress.  Without a
+/// registered function, the synchronisation is not held back (and a warning is
+/// reported), except for the default SystemC synchronisation function, which
+/// waits for a delta cycle.  An empty function resets the registration.
+/// Returns the previously registered function.
+host::sync_fn_type
+register_block_sync(host::sync_fn_type fn);
+
+/// Set the number of threads used for committing the streams in sync().
+///
+/// With more than one thread, the streams of the scope are partitioned into
+/// independent parts of the stream graph (connected via readers, their
+/// listeners and the listeners' output streams), which are committed
+/// concurrently.  Each part is committed in the same order as in the serial
+/// case.  Listeners of different parts must not share any other state.
+/// A value of 0 selects the number of hardware threads, 1 (the default)
+/// disables concurrent synchronisation.
+void
+set_sync_concurrency(unsigned num_threads);
+
+/// Dispatch of listener notifications (see set_notify_mode())
+enum class notify_mode
+{
+  immediate, ///< notify from within the commit of the stream (default)
+  deferred,  ///< queue notifications, dispatch them after the commit
+  parallel   ///< deferred, notify independent listeners concurrently
+};
+
+/// Select how readers notify their listeners.
+///
+/// Processors commit their outputs from within their notification, so an
+/// immediate notification traverses a chain of processors recursively within
+/// the commit of the first stream.  In the deferred mode, notifications are
+/// queued in a worklist of the calling thread, ordered by the depth of the
+/// deepest input stream of their listener in the stream graph, and dispatched
+/// iteratively at the end of the outermost commit.  A listener is not notified
+/// for a reader it has already consumed in the meantime.
+///
+/// The parallel mode additionally notifies the listeners of the same depth
+/// concurrently on the threads of set_sync_concurrency().  Each
+/// listener is notified on a single thread at a time and the order of the
+/// notifications does not depend on the scheduling, so the results match the
+/// other modes.  Listeners must therefore not share mutable state apart from
+/// the connecting streams.  Stream graphs with cycles are notified serially.
+void
+set_notify_mode(notify_mode mode);
+
+notify_mode
+get_notify_mode();
+
 /// Perform a commit until the maximum local time offset of all streams in the
 /// scope.
 ///
@@ -116,18 +183,31 @@ private:
 #ifndef SYSX_NO_SYSTEMC
 typedef sc_core::sc_object named_object;
 #else
+/// Native object hierarchy, modelled after the sc_core::sc_object interface.
+///
+/// Objects are created as children of the current scope of the calling thread
+/// (see host::scope_guard) and their name is prefixed with the hierarchical
+/// name of the scope.  Objects created outside of any scope are top-level
+/// objects.
 class named_object
 {
 public:
   virtual const char* name() const;
   virtual const char* kind() const;
 
-  virtual const char* basename() const { return name(); }
+  virtual const char* basename() const { return name_ + base_; }
 
   virtual void print(std::ostream& out) const {
     out << name();
   }
 
+  named_object* get_parent_object() const { return parent_; }
+
+  std::vector<named_object*> const& get_child_objects() const
+  {
+    return children_;
+  }
+
 protected:
   named_object(const char* nm);
 
@@ -135,8 +215,48 @@ protected:
   virtual ~named_object();
 
 private:
-  std::string name_;
+  named_object* parent_;
+  std::vector<named_object*> children_;
+  const char* name_; ///< interned hierarchical name
+  std::size_t base_;
+};
+
+/// Named hierarchy node for native hosts, similar to an sc_core::sc_module.
+class object_scope : public named_object
+{
+public:
+  explicit object_scope(const char* nm)
+    : named_object(nm)
+  {}
+
+  const char* kind() const override { return "object_scope"; }
+
+  ~object_scope() override = default;
+};
+
+namespace host {
+
+/// Make an object the current scope of the calling thread.
+///
+/// Objects created while the guard is alive become children of the scope,
+/// stream lookups fall back to names relative to the scope, and sync()
+/// commits the streams within the scope.  Guards nest and restore the
+/// previous scope on destruction.
+class scope_guard : private sysx::utils::noncopyable
+{
+public:
+  explicit scope_guard(named_object& scope);
+  ~scope_guard();
+
+private:
+  named_object* prev_;
 };
+
+/// current scope of the calling thread, nullptr at the top-level
+named_object*
+current_scope();
+
+} // namespace host
 #endif // SYSX_NO_SYSTEMC
 
 class timed_object : public named_object, public timed_base
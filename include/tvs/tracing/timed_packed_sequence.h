@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_packed_sequence.h
+ * \brief  compact sequence of timed values for bool/enum states
+ * \see    timed_sequence.h
+ *
+ * A \ref timed_packed_sequence stores the values of small enumerable types
+ * (\c bool, enumerations and byte-sized integers) as bits or bytes and the
+ * tuple durations as variable-length integers of time ticks.  This reduces
+ * the memory per transition of long state traces considerably compared to a
+ * \ref timed_sequence.  Tuples are decoded into proxy values on iteration.
+ */
+
+#ifndef TVS_TIMED_PACKED_SEQUENCE_H_INCLUDED_
+#define TVS_TIMED_PACKED_SEQUENCE_H_INCLUDED_
+
+#include <tvs/tracing/timed_recorder.h>
+#include <tvs/tracing/timed_sequence.h>
+#include <tvs/tracing/timed_stream_traits.h>
+
+#include <tvs/utils/assert.h>
+
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace tracing {
+
+namespace impl {
+
+/// conversion between durations and integral time ticks
+struct packed_ticks
+{
+  typedef std::uint64_t tick_type;
+
+#ifndef SYSX_NO_SYSTEMC
+  // SystemC time resolution
+  static tick_type to_ticks(timed_duration const& d)
+  {
+    return d.value().value();
+  }
+
+  static timed_duration from_ticks(tick_type t)
+  {
+    return timed_duration(sc_core::sc_time::from_value(t));
+  }
+#else
+  // picosecond resolution
+  static double resolution() { return 1e-12; }
+
+  static tick_type to_ticks(timed_duration const& d)
+  {
+    auto ticks = std::llround(d.value().value() / resolution());
+    return static_cast<tick_type>(ticks);
+  }
+
+  static timed_duration from_ticks(tick_type t)
+  {
+    return timed_duration(
+      time_type::from_value(static_cast<double>(t) * resolution()));
+  }
+#endif
+};
+
+/// bit width of the packed representation of a value
+template<typename T>
+struct packed_value_traits
+{
+  static_assert(std::is_enum<T>::value || std::is_integral<T>::value,
+                "packed sequences require an enumerable value type");
+
+  static const unsigned bits = 8;
+
+  static std::uint8_t encode(T v)
+  {
+    auto raw = static_cast<long long>(v);
+    SYSX_ASSERT(raw >= 0 && raw < 256 && "value not representable in a byte");
+    return static_cast<std::uint8_t>(raw);
+  }
+
+  static T decode(std::uint8_t raw) { return static_cast<T>(raw); }
+};
+
+template<>
+struct packed_value_traits<bool>
+{
+  static const unsigned bits = 1;
+
+  static std::uint8_t encode(bool v) { return v; }
+  static bool decode(std::uint8_t raw) { return raw != 0; }
+};
+
+} // namespace impl
+
+/**
+ * \brief compact, append-only sequence of state tuples
+ *
+ * All but the last tuple are stored in packed form, the last tuple is kept
+ * decoded to allow joining with subsequent tuples and to support an infinite
+ * duration.  Consumed tuples are removed with pop_front(), the storage is
+ * compacted once most of it has been consumed.
+ *
+ * Durations are quantised to the SystemC time resolution (or to picoseconds
+ * in native builds).  Splitting follows the state semantics, i.e. the value
+ * of a split tuple is kept.
+ */
+template<typename T, typename Traits = timed_state_traits<T>>
+class timed_packed_sequence : public timed_sequence_base
+{
+  typedef impl::packed_value_traits<T> packing;
+  typedef impl::packed_ticks ticks;
+
+public:
+  typedef timed_sequence_base base_type;
+  typedef timed_packed_sequence this_type;
+  typedef base_type::duration_type duration_type;
+
+  typedef T value_type;
+  typedef Traits traits_type;
+  typedef timed_value<T> tuple_type;
+  typedef typename traits_type::join_policy join_policy;
+  typedef std::size_t size_type;
+
+  /// forward iterator decoding proxy tuples
+  class const_iterator
+  {
+    friend class timed_packed_sequence;
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef tuple_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef tuple_type const* pointer;
+    typedef tuple_type const& reference;
+
+    const_iterator()
+      : seq_()
+      , idx_()
+      , pos_()
+    {}
+
+    reference operator*() const { return cur_; }
+    pointer operator->() const { return &cur_; }
+
+    const_iterator& operator++()
+    {
+      ++idx_;
+      decode();
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    friend bool operator==(const_iterator const& a, const_iterator const& b)
+    {
+      return a.idx_ == b.idx_;
+    }
+    friend bool operator!=(const_iterator const& a, const_iterator const& b)
+    {
+      return !(a == b);
+    }
+
+  private:
+    const_iterator(this_type const* seq, size_type idx, size_type pos)
+      : seq_(seq)
+      , idx_(idx)
+      , pos_(pos)
+    {
+      decode();
+      if (idx_ == seq_->head_ && idx_ < seq_->end_index())
+        cur_.duration(cur_.duration() - seq_->consumed_);
+    }
+
+    void decode()
+    {
+      if (idx_ < seq_->packed_)
+        cur_ = seq_->decode(idx_, pos_);
+      else if (idx_ == seq_->packed_ && seq_->has_last_)
+        cur_ = seq_->last_;
+    }
+
+    this_type const* seq_;
+    size_type idx_;
+    size_type pos_; ///< offset of the next tick in the duration buffer
+    tuple_type cur_;
+  };
+
+  timed_packed_sequence()
+    : base_type()
+    , values_()
+    , ticks_()
+    , packed_()
+    , head_()
+    , head_pos_()
+    , consumed_()
+    , last_()
+    , has_last_()
+  {}
+
+  size_type size() const { return end_index() - head_; }
+  bool empty() const { return size() == 0; }
+
+  void clear() { *this = this_type(); }
+
+  /** \name append to the sequence */
+  ///\{
+  void push_back(value_type const& v, duration_type const& d)
+  {
+    push_back(tuple_type(v, d));
+  }
+
+  void push_back(tuple_type const& t, bool join = true)
+  {
+    SYSX_ASSERT(!has_last_ || !last_.is_infinite());
+
+    if (has_last_ && join && join_policy::join(last_, t)) {
+      add_duration(t.duration());
+      return;
+    }
+    if (has_last_)
+      encode(last_);
+    last_ = t;
+    has_last_ = true;
+    add_duration(t.duration());
+  }
+
+  template<typename InputIterator>
+  void push_back(InputIterator from, InputIterator to)
+  {
+    while (from != to)
+      push_back(*from++);
+  }
+
+  template<typename SequenceType>
+  void push_back(SequenceType const& seq)
+  {
+    push_back(seq.begin(), seq.end());
+  }
+  ///\}
+
+  /** \name access and consume the head of the sequence */
+  ///\{
+  tuple_type front() const
+  {
+    SYSX_ASSERT(!empty());
+    return *begin();
+  }
+
+  tuple_type const& back() const
+  {
+    SYSX_ASSERT(!empty());
+    return last_;
+  }
+
+  duration_type front_duration() const { return front().duration(); }
+
+  /// remove the front tuple
+  void pop_front()
+  {
+    SYSX_ASSERT(!empty());
+    del_duration(front_duration());
+    consumed_ = duration_type();
+
+    if (head_ == packed_) {
+      clear();
+      return;
+    }
+    decode(head_++, head_pos_);
+    compact();
+  }
+
+  /// remove the given duration from the front (splitting the front tuple)
+  void pop_front(duration_type d)
+  {
+    while (!empty() && d > duration_type::zero_time && front_duration() <= d) {
+      d -= front_duration();
+      pop_front();
+    }
+    if (!empty() && d > duration_type::zero_time) {
+      if (head_ == packed_) {
+        last_.duration(last_.duration() - d);
+      } else {
+        consumed_ += d;
+      }
+      del_duration(d);
+    }
+  }
+  ///\}
+
+  /** \name const tuple iterators */
+  ///\{
+  const_iterator begin() const
+  {
+    return const_iterator(this, head_, head_pos_);
+  }
+  const_iterator end() const { return const_iterator(this, end_index(), 0); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  ///\}
+
+  /// approximate number of allocated bytes
+  size_type memory_usage() const
+  {
+    return sizeof(*this) + values_.capacity() + ticks_.capacity();
+  }
+
+private:
+  size_type end_index() const { return packed_ + (has_last_ ? 1 : 0); }
+
+  void encode(tuple_type const& t)
+  {
+    // values
+    auto raw = packing::encode(t.value());
+    if (packing::bits == 1) {
+      if (packed_ % 8 == 0)
+        values_.push_back(0);
+      values_.back() |= static_cast<std::uint8_t>(raw << (packed_ % 8));
+    } else {
+      values_.push_back(raw);
+    }
+
+    // durations (LEB128)
+    auto tick = ticks::to_ticks(t.duration());
+    do {
+      std::uint8_t byte = tick & 0x7f;
+      tick >>= 7;
+      ticks_.push_back(byte | (tick ? 0x80 : 0));
+    } while (tick);
+
+    ++packed_;
+  }
+
+  tuple_type decode(size_type idx, size_type& pos) const
+  {
+    std::uint8_t raw = (packing::bits == 1)
+                         ? (values_[idx / 8] >> (idx % 8)) & 1
+                         : values_[idx];
+
+    ticks::tick_type tick = 0;
+    unsigned shift = 0;
+    std::uint8_t byte;
+    do {
+      byte = ticks_[pos++];
+      tick |= ticks::tick_type(byte & 0x7f) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+
+    return tuple_type(packing::decode(raw), ticks::from_ticks(tick));
+  }
+
+  // drop consumed storage once it dominates
+  void compact()
+  {
+    if (head_ < 1024 || head_ * 2 < packed_)
+      return;
+
+    // keep the bit offset within the first value byte intact
+    size_type skip = (packing::bits == 1) ? head_ / 8 * 8 : head_;
+    values_.erase(values_.begin(), values_.begin() + skip * packing::bits / 8);
+    ticks_.erase(ticks_.begin(), ticks_.begin() + head_pos_);
+    packed_ -= skip;
+    head_ -= skip;
+    head_pos_ = 0;
+  }
+
+  std::vector<std::uint8_t> values_;
+  std::vector<std::uint8_t> ticks_;
+  size_type packed_;   ///< number of encoded tuples (including consumed ones)
+  size_type head_;     ///< index of the front tuple
+  size_type head_pos_; ///< offset of the front duration in ticks_
+  duration_type consumed_; ///< already consumed part of the front tuple
+  tuple_type last_;
+  bool has_last_;
+}; // timed_packed_sequence
+
+/// record a state stream into a packed sequence (see timed_recorder)
+template<typename T, typename Traits = timed_state_traits<T>>
+using timed_packed_recorder = timed_recorder<timed_packed_sequence<T, Traits>>;
+
+} // namespace tracing
+
+#endif /* TVS_TIMED_PACKED_SEQUENCE_H_INCLUDED_ */
+/* Taf!
+ */
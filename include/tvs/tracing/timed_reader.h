@@ -28,6 +28,12 @@
 #include <tvs/tracing/timed_reader_base.h>
 #include <tvs/tracing/timed_sequence.h>
 #include <tvs/tracing/timed_variant.h>
+#include <tvs/tracing/timed_window_view.h>
+#include <tvs/utils/spill_segments.h>
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
 
 namespace tracing {
 
@@ -53,11 +59,15 @@ public:
   typedef timed_value<T> tuple_type;
 
   typedef typename stream_type::sequence_type sequence_type;
+  typedef typename sequence_type::memory_resource memory_resource;
   typedef typename traits_type::split_policy split_policy;
+  typedef typename traits_type::join_policy join_policy;
 
   typedef typename sequence_type::const_iterator const_iterator;
   typedef typename sequence_type::range_type range_type;
   typedef typename sequence_type::const_range_type const_range_type;
+  typedef timed_cursor<T, Traits> cursor_type;
+  typedef timed_window_view<T, Traits> window_type;
 
   /** \name constructors */
   ///\{
@@ -85,12 +95,25 @@ public:
 
   ///\}
 
+  /// memory resource of the reader buffer (default resource at construction)
+  memory_resource* resource() const { return buf_.resource(); }
+
   // read a value at a given time (between start and end time)
   value_type const& get() const { return front().value(); }
   // allow modifying the value of the front tuple
   value_type& get() { return buf_.front().value(); }
-  value_type const& get(time_type const& offset) const;
-  value_type const& get(duration_type const& offset) const;
+  // the value at an offset has to be held in memory (see buffer_policy::spill)
+  value_type const& get(time_type const& offset) const
+  {
+    return get(duration_type(offset - local_time()));
+  }
+  value_type const& get(duration_type const& offset) const
+  {
+    SYSX_ASSERT(offset < buf_.duration() && "value not held in memory");
+    cursor_type cur(buf_);
+    cur.advance(offset);
+    return cur.position()->value();
+  }
 
   // read (and potentially split) the first tuple
   tuple_type const& front() const override { return buf_.front(); }
@@ -124,12 +147,35 @@ public:
     return front_variant();
   }
 
-  /** \name const tuple iterators */
+  /** \name const tuple iterators
+   *
+   * Iterating a non-const reader pages in all spilled tuples first (see
+   * buffer_policy::spill), the const overloads require all tuples to be held
+   * in memory.
+   */
   ///\{
-  const_iterator begin() const { return buf_.begin(); }
-  const_iterator end() const { return buf_.end(); }
-  const_iterator cbegin() const { return buf_.begin(); }
-  const_iterator cend() const { return buf_.end(); }
+  const_iterator begin()
+  {
+    page_in_tuples(spilled());
+    return buf_.begin();
+  }
+  const_iterator end()
+  {
+    page_in_tuples(spilled());
+    return buf_.end();
+  }
+  const_iterator begin() const
+  {
+    SYSX_ASSERT(!spilled() && "tuples not held in memory");
+    return buf_.begin();
+  }
+  const_iterator end() const
+  {
+    SYSX_ASSERT(!spilled() && "tuples not held in memory");
+    return buf_.end();
+  }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
   ///\}
 
   // ---------------------------------------------------------------------
@@ -137,12 +183,14 @@ public:
   ///\{
   range_type before(duration_type const& until)
   {
+    page_in(until);
     buf_.split(until);
     return buf_.before(until);
   }
 
   const_range_type before(duration_type const& until) const
   {
+    SYSX_ASSERT(until <= buf_.duration() && "tuples not held in memory");
     buf_.split(until);
     return buf_.before(until);
   }
@@ -153,11 +201,13 @@ public:
 
   range_type range(duration_type const& until)
   {
+    page_in(until);
     buf_.split(until);
     return buf_.range(until);
   }
   const_range_type range(duration_type const& until) const
   {
+    SYSX_ASSERT(until <= buf_.duration() && "tuples not held in memory");
     buf_.split(until);
     return buf_.range(until);
   }
@@ -168,6 +218,7 @@ public:
 
   range_type range(duration_type const& from, duration_type const& to)
   {
+    page_in(to);
     buf_.split(from);
     buf_.split(to);
     return buf_.range(from, to);
@@ -175,6 +226,7 @@ public:
   const_range_type range(duration_type const& from,
                          duration_type const& to) const
   {
+    SYSX_ASSERT(to <= buf_.duration() && "tuples not held in memory");
     buf_.split(from);
     buf_.split(to);
     return buf_.range(from, to);
@@ -186,25 +238,222 @@ public:
   }
   ///\}
 
-  size_type count() const override { return buf_.size(); }
-  duration_type available_duration() const override { return buf_.duration(); }
+  // ---------------------------------------------------------------------
+  /** \name non-splitting views (see timed_window_view.h)
+   *
+   * Views do not modify the buffer and are invalidated by any modification
+   * of the reader (pop, commit).  The non-const overloads page in the
+   * covered spilled tuples first (see buffer_policy::spill), the const
+   * overloads require them to be held in memory.
+   */
+  ///\{
+  cursor_type cursor()
+  {
+    page_in_tuples(spilled());
+    return cursor_type(buf_);
+  }
+  cursor_type cursor() const
+  {
+    SYSX_ASSERT(!spilled() && "tuples not held in memory");
+    return cursor_type(buf_);
+  }
+
+  /// consume the tuples passed by a cursor of this reader
+  void pop_until(cursor_type const& cur)
+  {
+    auto n = cur.position() - buf_.begin();
+    while (n-- > 0)
+      base_type::pop();
+    if (cur.skipped() > duration_type::zero_time)
+      base_type::pop_duration(cur.skipped());
+  }
+  using base_type::pop_until;
+
+  window_type window(duration_type const& until)
+  {
+    return window(duration_type(), until);
+  }
+  window_type window(duration_type const& until) const
+  {
+    return window(duration_type(), until);
+  }
+
+  window_type window(duration_type const& from, duration_type const& to)
+  {
+    page_in(to);
+    return window_type(buf_, from, to);
+  }
+  window_type window(duration_type const& from, duration_type const& to) const
+  {
+    SYSX_ASSERT(to <= buf_.duration() && "tuples not held in memory");
+    return window_type(buf_, from, to);
+  }
+  ///\}
+
+  size_type count() const override { return buf_.size() + spilled(); }
+  duration_type available_duration() const override
+  {
+    return buf_.duration() + spill_duration_;
+  }
 
+  /// print the tuples held in memory and the number of spilled tuples
   void print(std::ostream& os = std::cout) const override
   {
     os << name() << "@" << local_time() << ": " << buf_;
+    if (spilled())
+      os << " (+" << spilled() << " spilled)";
   }
 
 private:
+  typedef sysx::utils::spill_queue<tuple_type> spill_type;
+
   void do_pop_duration(duration_type const& d) override
   {
+    page_in(d);
     buf_.split(d);
     duration_type rem = buf_.pop_front(d);
 
     SYSX_ASSERT(rem == duration_type::zero_time || buf_.empty());
+
+    // keep the front of the stream in memory
+    if (buf_.empty() && spilled())
+      page_in_tuples(std::max<size_type>(1, buffer_limit() / 2));
+
     commit(d);
   }
 
+  /** \name spilling to secondary storage */
+  ///\{
+  size_type spilled() const override { return spill_ ? spill_->size() : 0; }
+
+  bool can_spill() const override
+  {
+    return std::is_trivially_copyable<value_type>::value;
+  }
+
+  size_type do_spill(size_type max_tuples) override
+  {
+    // only the tail of the in-memory buffer can be spilled
+    if (spilled() || buf_.size() <= max_tuples)
+      return 0;
+
+    if (!spill_)
+      spill_.reset(new spill_type());
+
+    size_type keep = std::max<size_type>(1, max_tuples / 2);
+    sequence_type head(buf_.resource());
+    auto it = buf_.begin();
+    for (size_type i = 0; i < keep; ++i)
+      head.push_back(*it++, /* join = */ false);
+    for (; it != buf_.end(); ++it) {
+      spill_->push_back(*it);
+      spill_duration_ += it->duration();
+    }
+    size_type ret = buf_.size() - keep;
+    buf_.swap(head);
+    return ret;
+  }
+
+  // load spilled tuples until the given duration is available in memory
+  void page_in(duration_type const& until)
+  {
+    while (spilled() && buf_.duration() < until)
+      page_in_tuples(1);
+  }
+
+  void page_in_tuples(size_type n)
+  {
+    for (; n > 0 && spilled(); --n) {
+      auto const& t = spill_->front();
+      spill_duration_ -= t.duration();
+      buf_.push_back(t);
+      spill_->pop_front();
+    }
+    if (!spilled())
+      spill_duration_ = duration_type();
+  }
+
+  // append committed tuples (behind any spilled tuples)
+  void append(sequence_type& seq, bool move)
+  {
+    if (spilled()) {
+      append(seq.begin(), seq.end());
+      if (move)
+        seq.clear();
+      return;
+    }
+    size_type before = buf_.size();
+    if (move)
+      buf_.move_back(seq);
+    else
+      buf_.push_back(seq);
+    fresh_ += buf_.size() - before;
+  }
+
+  template<typename InputIterator>
+  void append(InputIterator from, InputIterator to)
+  {
+    if (!spilled()) {
+      size_type before = buf_.size();
+      buf_.push_back(from, to);
+      fresh_ += buf_.size() - before;
+      return;
+    }
+    for (; from != to; ++from) {
+      spill_->push_back(*from);
+      spill_duration_ += from->duration();
+    }
+  }
+  ///\}
+
+  // Only the tuples appended since the last call are joined, together with
+  // the front tuple split by a consumer (see front(duration_type)).
+  size_type do_coalesce() override
+  {
+    fresh_ += spilled();
+    page_in_tuples(spilled());
+    size_type before = buf_.size();
+
+    // re-append the fresh tail, joining it to the already joined head
+    size_type fresh = std::min(fresh_, buf_.size());
+    fresh_ = 0;
+    sequence_type tail(buf_.resource());
+    tail.push_back(buf_.end() - fresh, buf_.end());
+    for (size_type i = 0; i < fresh; ++i)
+      buf_.pop_back();
+    for (auto const& t : tail)
+      buf_.push_back(t); // joins according to the stream's join_policy
+
+    if (buf_.size() > 1) {
+      tuple_type head = buf_.front();
+      buf_.pop_front();
+      if (join_policy::join(head, buf_.front()))
+        buf_.pop_front();
+      buf_.push_front(head);
+    }
+    return before - buf_.size();
+  }
+
+  size_type do_drop_oldest(size_type max_tuples) override
+  {
+    page_in_tuples(spilled());
+
+    // keep the most recent tuples and replace the dropped ones by a single
+    // empty tuple to preserve the reader's time alignment
+    size_type drop = buf_.size() - max_tuples + 1;
+    duration_type gap;
+    for (size_type i = 0; i < drop; ++i) {
+      gap += buf_.front_duration();
+      buf_.pop_front();
+    }
+    buf_.push_front(traits_type::empty_policy::empty(gap));
+    return drop;
+  }
+
   sequence_type buf_;
+  std::unique_ptr<spill_type> spill_;
+  duration_type spill_duration_;
+  size_type fresh_ = 0; // appended tuples, not yet coalesced
 };
 
 } // namespace tracing
@@ -29,6 +29,8 @@
 #include <tvs/tracing/timed_value.h>
 #include <tvs/tracing/timed_variant.h>
 
+#include <vector>
+
 namespace tracing {
 
 // forward declarations
@@ -42,6 +44,13 @@ class timed_listener_if
 public:
   virtual void notify(timed_reader_base& s) = 0;
 
+  /// Add the streams written by this listener in response to a notification.
+  ///
+  /// This is used to determine independent parts of the stream graph (see
+  /// set_sync_concurrency()).  Listeners which only consume their inputs do
+  /// not need to override this.
+  virtual void collect_downstream(std::vector<timed_stream_base*>&) const {}
+
 protected:
   typedef unsigned listener_mode;
 
@@ -58,9 +67,33 @@ protected:
 
 }; // class timed_listener_if
 
+/// policy to apply when a reader exceeds its buffer limit
+enum class buffer_policy
+{
+  unbounded,   ///< no limit (default)
+  block,       ///< keep all tuples, see register_block_sync()
+  drop_oldest, ///< replace the oldest tuples by a single empty tuple
+  coalesce,    ///< join adjacent tuples first, then drop the oldest ones
+  spill        ///< move newer tuples to memory-mapped temporary files
+};
+
+/// buffer statistics of a reader (see timed_reader_base::statistics())
+struct timed_reader_statistics
+{
+  typedef std::size_t size_type;
+
+  timed_duration lag;   ///< buffered, not yet consumed duration
+  size_type count;      ///< currently buffered tuples
+  size_type high_water; ///< maximum number of tuples after a commit
+  size_type dropped;    ///< tuples discarded by buffer_policy::drop_oldest
+  size_type coalesced;  ///< tuples joined by buffer_policy::coalesce
+  size_type spilled;    ///< tuples currently kept in secondary storage
+};
+
 class timed_reader_base : public timed_object
 {
   friend class timed_stream_base;
+  friend void host::sync_with_model(time_type);
   typedef timed_stream_base stream_type;
 
 public:
@@ -115,6 +148,24 @@ public:
   virtual stream_type& stream() { return *stream_; }
   virtual stream_type const& stream() const { return *stream_; }
 
+  /// currently registered listener (if any)
+  timed_listener_if* listener() const { return listener_; }
+
+  /** \name bounded buffering */
+  ///\{
+  /// limit the number of buffered tuples (0: unbounded)
+  void set_buffer_limit(size_type max_tuples,
+                        buffer_policy policy = buffer_policy::drop_oldest);
+
+  size_type buffer_limit() const { return buffer_limit_; }
+  buffer_policy limit_policy() const { return buffer_policy_; }
+
+  /// does this reader hold back its writer (buffer_policy::block)?
+  bool blocking() const;
+
+  timed_reader_statistics statistics() const;
+  ///\}
+
   void print(std::ostream&) const override = 0;
 
 protected:
@@ -129,6 +180,18 @@ protected:
   virtual void do_pop_duration(duration_type const&) = 0;
   void trigger(bool new_window);
 
+  /// join adjacent tuples, returns the number of removed tuples
+  virtual size_type do_coalesce() = 0;
+  /// shrink buffer to \a max_tuples, returns the number of removed tuples
+  virtual size_type do_drop_oldest(size_type max_tuples) = 0;
+
+  /// number of tuples in secondary storage (included in count())
+  virtual size_type spilled() const { return 0; }
+  /// can tuples of this reader be spilled (trivially copyable values)?
+  virtual bool can_spill() const { return false; }
+  /// spill tuples beyond \a max_tuples, returns the number of spilled tuples
+  virtual size_type do_spill(size_type) { return 0; }
+
 private:
   friend std::ostream& operator<<(std::ostream& os, timed_reader_base const& t)
   {
@@ -136,9 +199,24 @@ private:
     return os;
   }
 
+  // called by the stream after each commit
+  void enforce_buffer_limit();
+  // track attached readers with buffer_policy::block
+  void update_block_count();
+
   stream_type* stream_;
   timed_listener_if* listener_;
   listener_mode listen_mode_;
+
+  size_type buffer_limit_;
+  buffer_policy buffer_policy_;
+  size_type high_water_;
+  size_type dropped_;
+  size_type coalesced_;
+  bool block_reported_; // warned about holding back the synchronisation
+  bool block_counted_;  // included in num_blocking_
+
+  static size_type num_blocking_; // attached readers with buffer_policy::block
 };
 
 inline bool
@@ -159,12 +237,10 @@ timed_reader_base::available_until() const
   return local_time() + available_duration();
 }
 
-inline void
-timed_reader_base::trigger(bool new_window)
+inline bool
+timed_reader_base::blocking() const
 {
-  if (listen_mode_ & (new_window ? timed_listener_if::NOTIFY_WINDOW
-                                 : timed_listener_if::NOTIFY_APPEND))
-    listener_->notify(*this);
+  return buffer_policy_ == buffer_policy::block && count() > buffer_limit_;
 }
 
 inline void
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_recorder.h
+ * \brief  record the tuples of a stream into an archive sequence
+ * \see    timed_packed_sequence.h, timed_compressed_sequence.h
+ */
+
+#ifndef TVS_TIMED_RECORDER_H_INCLUDED_
+#define TVS_TIMED_RECORDER_H_INCLUDED_
+
+#include <tvs/tracing/timed_reader.h>
+#include <tvs/tracing/timed_stream.h>
+
+namespace tracing {
+
+/**
+ * \brief record a stream into a sequence
+ *
+ * The recorder consumes all tuples of the given stream as soon as they are
+ * committed and appends them to a sequence of type \a Sequence, e.g. one of
+ * the compact archive formats.
+ */
+template<typename Sequence>
+class timed_recorder : public timed_listener_if
+{
+public:
+  typedef Sequence sequence_type;
+  typedef typename sequence_type::value_type value_type;
+  typedef typename sequence_type::traits_type traits_type;
+  typedef timed_reader<value_type, traits_type> reader_type;
+  typedef timed_stream<value_type, traits_type> stream_type;
+
+  timed_recorder(const char* name, stream_type& stream)
+    : reader_(name, stream)
+    , seq_()
+  {
+    reader_.listen(*this);
+  }
+
+  timed_recorder(const char* name, const char* stream_name)
+    : reader_(name, stream_name)
+    , seq_()
+  {
+    reader_.listen(*this);
+  }
+
+  sequence_type const& sequence() const { return seq_; }
+  sequence_type& sequence() { return seq_; }
+
+  void notify(timed_reader_base&) override
+  {
+    seq_.push_back(reader_.begin(), reader_.end());
+    reader_.pop_all();
+  }
+
+private:
+  reader_type reader_;
+  sequence_type seq_;
+};
+
+} // namespace tracing
+
+#endif /* TVS_TIMED_RECORDER_H_INCLUDED_ */
+/* Taf!
+ */
@@ -30,7 +30,10 @@
 
 #include <tvs/tracing/timed_value.h>
 
+#include <tvs/utils/memory_resource.h>
+
 #include <deque>
+#include <utility>
 
 namespace tracing {
 
@@ -57,36 +60,70 @@ public:
   typedef tracing::timed_duration duration_type;
 
   /// currently held duration of the sequence
-  duration_type duration() const { return duration_; }
+  duration_type duration() const
+  {
+    return infinite_ ? duration_type::infinity() : duration_;
+  }
+
+  /// duration of the finite tuples (excluding an infinite tail)
+  duration_type finite_duration() const { return duration_; }
 
   /// infinite sequence?
-  bool is_infinite() const { return duration_.is_infinite(); }
+  bool is_infinite() const { return infinite_; }
 
 protected:
   timed_sequence_base()
     : duration_()
+    , infinite_()
   {}
 
-  /// update duration (from concrete sequence)
-  void set_duration(duration_type const& d) { duration_ = d; }
+  /// reset duration (from concrete sequence)
+  void set_duration(duration_type const& d)
+  {
+    infinite_ = d.is_infinite();
+    duration_ = infinite_ ? duration_type() : d;
+  }
 
   /// extend duration (from concrete sequence)
-  void add_duration(duration_type const& d) { duration_ += d; }
+  void add_duration(duration_type const& d)
+  {
+    if (d.is_infinite()) {
+      infinite_ = true;
+    } else {
+      duration_ += d;
+    }
+  }
+
+  /// extend duration by the tuples in [from, to)
+  template<typename InputIterator>
+  void add_durations(InputIterator from, InputIterator to)
+  {
+    for (; from != to; ++from)
+      add_duration(from->duration());
+  }
 
   /// shrink duration (from concrete sequence)
   void del_duration(duration_type const& d)
   {
-    if (!duration_.is_infinite()) {
+    if (d.is_infinite()) {
+      SYSX_ASSERT(infinite_);
+      infinite_ = false;
+    } else if (!infinite_) {
       SYSX_ASSERT(d <= duration_);
       duration_ -= d;
-    } else if (d.is_infinite()) {
-      duration_ = duration_type::zero_time;
-    } else {
-      SYSX_ASSERT(!d.is_infinite());
+    } else { // may consume the infinite tail (saturates at zero)
+      duration_ -= d;
     }
   }
 
-  duration_type duration_;
+  void swap_duration(timed_sequence_base& that)
+  {
+    duration_.swap(that.duration_);
+    std::swap(infinite_, that.infinite_);
+  }
+
+  duration_type duration_; ///< sum of the finite tuple durations
+  bool infinite_;          ///< last tuple has an infinite duration
 };
 
 template<typename T, typename Traits>
@@ -109,7 +146,9 @@ public:
 
   typedef T value_type;
   typedef timed_value<T> tuple_type;
-  typedef std::deque<tuple_type> storage_type;
+  typedef sysx::utils::memory_resource memory_resource;
+  typedef sysx::utils::polymorphic_allocator<tuple_type> allocator_type;
+  typedef std::deque<tuple_type, allocator_type> storage_type;
 
   typedef Traits traits_type;
 
@@ -127,6 +166,17 @@ public:
 
   // ---------------------------------------------------------------------
 
+  /// empty sequence using the current default memory resource
+  timed_sequence() = default;
+
+  /// empty sequence using the given memory resource
+  explicit timed_sequence(memory_resource* r)
+    : buf_(allocator_type(r))
+  {}
+
+  /// memory resource of the tuple storage
+  memory_resource* resource() const { return buf_.get_allocator().resource(); }
+
   size_type size() const { return buf_.size(); }
 
   /// sequence is empty?
@@ -135,8 +185,17 @@ public:
   /// swap two sequences
   void swap(this_type& that)
   {
-    buf_.swap(that.buf_);
-    duration_.swap(that.duration_);
+    if (buf_.get_allocator() == that.buf_.get_allocator()) {
+      buf_.swap(that.buf_);
+    } else { // storage stays with its resource, exchange the contents
+      storage_type mine(
+        that.buf_.begin(), that.buf_.end(), buf_.get_allocator());
+      storage_type theirs(
+        buf_.begin(), buf_.end(), that.buf_.get_allocator());
+      buf_.swap(mine);
+      that.buf_.swap(theirs);
+    }
+    swap_duration(that);
   }
 
   /// empty the sequence
@@ -219,15 +278,9 @@ public:
   void front(tuple_type const& t)
   {
     SYSX_ASSERT(!t.is_infinite() || buf_.front().is_infinite());
-    duration_type d = buf_.front().duration();
+    del_duration(buf_.front().duration());
     buf_.front() = t;
-    if (t.is_infinite()) {
-      set_duration(duration_type::infinity());
-    } else if (t.duration() < d) { // shorter tuple
-      del_duration(d - t.duration());
-    } else {
-      add_duration(t.duration() - d);
-    }
+    add_duration(t.duration());
   }
 
   /// push an element to the front of the sequence
@@ -251,6 +304,7 @@ public:
     SYSX_ASSERT(!empty());
     del_duration(front().duration());
     buf_.pop_front();
+    resync_duration();
   }
 
   /// remove front of the sequence for a given duration.  In case of a zero-time
@@ -269,17 +323,23 @@ public:
     }
 
     auto it = buf_.begin();
+    duration_type popped;
     // don't remove zero-time tuples on the 'edge'
     while (it != buf_.end() && d >= it->duration()) {
       if (d == duration_type::zero_time &&
           it->duration() == duration_type::zero_time)
         break;
       d -= it->duration();
-      del_duration(it->duration());
+      popped += it->duration();
       ++it;
     }
-    if (it != buf_.begin()) // drop fully covered tuples
+    if (it == buf_.end()) {
+      clear(); // exact, the running duration may have rounded
+    } else if (it != buf_.begin()) { // drop fully covered tuples
+      del_duration(popped);
       buf_.erase(buf_.begin(), it);
+      resync_duration();
+    }
     return d;
   }
 
@@ -305,28 +365,16 @@ public:
   /// update/replace last element in the sequence
   void back(tuple_type const& t)
   {
-    // SYSX_ASSERT(!t.is_infinite());
-    duration_type d = buf_.back().duration();
+    del_duration(buf_.back().duration());
     buf_.back() = t;
-    if (t.duration() < d) { // shorter tuple
-      del_duration(d - t.duration());
-    } else {
-      add_duration(t.duration() - d);
-    }
+    add_duration(t.duration());
   }
 
   /// remove tail of the sequence
   void pop_back()
   {
     SYSX_ASSERT(!empty());
-    const_reference last = back();
-    if (!last.is_infinite()) {
-      del_duration(last.duration());
-    } else { // need to recompute duration
-      set_duration(duration_type());
-      for (const_iterator it = buf_.begin(); it != buf_.end() - 1; ++it)
-        add_duration(it->duration());
-    }
+    del_duration(back().duration());
     buf_.pop_back();
   }
   ///\}
@@ -410,8 +458,18 @@ public:
 
 protected:
   using base_type::add_duration;
+  using base_type::add_durations;
   using base_type::del_duration;
-  using base_type::duration_;
+
+  /// take the exact duration of a single remaining tuple, the running sum
+  /// may have been rounded in native time
+  void resync_duration()
+  {
+    if (size() == 1)
+      this->set_duration(buf_.front().duration());
+    else if (empty())
+      this->set_duration(duration_type());
+  }
 
   storage_type buf_;
 }; // timed_sequence
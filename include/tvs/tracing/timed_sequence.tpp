@@ -49,9 +49,8 @@ struct timed_sequence_do_push
                    OtherSequenceType const& seq)
   {
     if (buf.empty()) {
-      duration_type d = seq.duration(); // remember old duration for aliasing
       buf.insert(buf.end(), seq.begin(), seq.end());
-      this_.add_duration(d);
+      this_.add_durations(buf.begin(), buf.end());
     } else {
       // element-wise push
       this_.push_back(seq.begin(), seq.end());
@@ -80,9 +79,9 @@ struct timed_sequence_do_push<
                    storage_type& buf,
                    OtherSequenceType const& seq)
   {
-    duration_type d = seq.duration(); // remember old duration for aliasing
+    auto size = buf.size(); // remember old size for aliasing
     buf.insert(buf.end(), seq.begin(), seq.end());
-    this_.add_duration(d);
+    this_.add_durations(buf.begin() + size, buf.end());
   }
 
   ///\todo add front pushing
@@ -134,13 +133,15 @@ timed_sequence<T, Traits>::split(duration_type const& offset)
   // perform split of the last tuple (will shorten rhs)
   auto lhs = split_policy::split(rhs, offset - srange.offset());
 
-  this_type seq;
+  this_type seq(resource());
 
-  // push the rhs back (possibly infinite)
-  seq.push_back(rhs);
+  // keep zero-time tuples at the start of the split tuple
+  for (auto it = srange.begin(); it + 1 != srange.end(); ++it)
+    seq.push_back(*it, /* join = */ false);
 
-  // push the lhs to front (avoid join)
-  seq.push_front(lhs);
+  // push lhs and (possibly infinite) rhs, avoid join
+  seq.push_back(lhs, /* join = */ false);
+  seq.push_back(rhs, /* join = */ false);
 
   // replace old range with the new sequence
   srange.replace(seq);
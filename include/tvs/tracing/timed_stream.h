@@ -27,10 +27,13 @@
 
 #include <tvs/tracing/timed_sequence.h>
 #include <tvs/tracing/timed_stream_base.h>
+#include <tvs/tracing/timed_stream_policies.h>
 #include <tvs/tracing/timed_value.h>
 
 #include <tvs/tracing/report_msgs.h>
 
+#include <typeinfo>
+
 namespace tracing {
 
 template<typename, typename>
@@ -65,13 +68,25 @@ public:
   typedef typename Traits::empty_policy empty_policy;
   typedef typename Traits::split_policy split_policy;
   typedef typename Traits::merge_policy merge_policy;
+  typedef typename impl::zero_time_policy_of<Traits>::type zero_time_policy;
+
+  static_assert(impl::join_consistent<typename Traits::join_policy,
+                                      split_policy>::value,
+                "tolerant joins need timed_join_value_sum for extensive "
+                "values (timed_split_policy_average) and hold/average "
+                "otherwise");
 
   typedef timed_sequence<T, Traits> sequence_type;
+  typedef typename sequence_type::memory_resource memory_resource;
 
+  /// buffers are allocated from the current default memory resource
   explicit timed_stream(const char* nm = "timed_stream")
     : base_type(nm)
   {}
 
+  /// memory resource of the stream buffers
+  memory_resource* resource() const { return buf_.resource(); }
+
   duration_type duration() const override { return buf_.duration(); }
 
   void print(std::ostream& os = std::cout) const override;
@@ -113,6 +128,7 @@ protected:
 
 private:
   void merge_future(sequence_type&& other);
+  void move_future(duration_type const& dur);
 
   sequence_type buf_;
   sequence_type future_;
@@ -124,7 +140,14 @@ StreamType&
 stream_by_name(const char* stream)
 {
   using stream_type = StreamType;
-  auto str = dynamic_cast<stream_type*>(host::lookup(stream));
+  auto base = host::lookup(stream);
+
+  // avoid the dynamic_cast for exact type matches
+  stream_type* str = nullptr;
+  if (base != nullptr && typeid(*base) == typeid(stream_type))
+    str = static_cast<stream_type*>(base);
+  else
+    str = dynamic_cast<stream_type*>(base);
 
   if (str == nullptr) {
     SYSX_REPORT_ERROR(report::stream_lookup) % stream
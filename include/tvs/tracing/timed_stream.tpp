@@ -49,7 +49,7 @@ timed_stream<T, Traits>::merge_future(sequence_type&& other)
     return;
   }
 
-  sequence_type result;
+  sequence_type result(this_.resource());
   sequence_type *seq_a = &this_, *seq_b = &other;
 
   // iterate until one sequence is empty
@@ -59,20 +59,24 @@ timed_stream<T, Traits>::merge_future(sequence_type&& other)
     if (seq_a->front_duration() < seq_b->front_duration())
       std::swap(seq_a, seq_b);
 
-    // special case: handle 'split' at 0
-    if (seq_b->front_duration() == duration_type::zero_time) {
-      tuple_type zero_front = seq_a->front();
-      zero_front.duration(duration_type::zero_time);
-      seq_a->push_front(zero_front);
+    // special case: handle 'split' at 0, two zero-time fronts merge as is
+    if (seq_a->front_duration() == duration_type::zero_time) {
+      // nothing to split
+    } else if (seq_b->front_duration() == duration_type::zero_time) {
+      // let the split policy derive the zero-length value, A stays intact
+      tuple_type front = seq_a->front();
+      seq_a->push_front(split_policy::split(front, duration_type::zero_time));
     } else {
       // split the front tuple of A
       seq_a->split(seq_b->front_duration());
     }
 
-    tuple_type a_front = seq_a->front();
-    merge_policy::merge(a_front, seq_b->front());
-
-    result.push_back(a_front);
+    // merge the pushed tuple into the existing one, independent of the
+    // order of A and B (matters for non-commutative policies)
+    bool const a_exists = (seq_a == &this_);
+    tuple_type merged = a_exists ? seq_a->front() : seq_b->front();
+    merge_policy::merge(merged, a_exists ? seq_b->front() : seq_a->front());
+    result.push_back(merged);
     seq_b->pop_front();
     seq_a->pop_front();
   }
@@ -87,27 +91,59 @@ timed_stream<T, Traits>::merge_future(sequence_type&& other)
   this_.move_back(result);
 }
 
+template<typename T, typename Traits>
+void
+timed_stream<T, Traits>::move_future(duration_type const& dur)
+{
+  auto range = future_.range(dur);
+
+  SYSX_ASSERT(range.duration() == dur);
+
+  // absorbed zero-time tuples are folded into their successor, those at the
+  // end of the range stay in the future
+  tuple_type folded;
+  bool folding = false;
+  for (auto const& t : range) {
+    if (zero_time_policy::absorb(t)) {
+      if (folding)
+        merge_policy::merge(folded, t);
+      else
+        folded = t;
+      folding = true;
+    } else if (folding) {
+      tuple_type next(folded.value(), t.duration());
+      merge_policy::merge(next, t);
+      buf_.push_back(next);
+      folding = false;
+    } else {
+      buf_.push_back(t);
+    }
+  }
+  future_.pop_front(dur);
+}
+
 /* -------------------------- push interface -------------------------- */
 
 template<typename T, typename P>
 void
 timed_stream<T, P>::push(tuple_type const& t)
 {
-  if (future_.empty()) {
+  bool const absorb = zero_time_policy::absorb(t);
+  if (absorb && !impl::merge_allowed<merge_policy>::value)
+    return; // superseded by the successor
+
+  if (future_.empty() && !absorb) {
     buf_.push_back(t);
   } else {
 
     // consume any future values caused by the local offset increment
-    sequence_type tmp;
+    sequence_type tmp(future_.resource());
     tmp.push_back(t);
     merge_future(std::move(tmp));
 
-    auto merge_range = future_.range(t.duration());
-
-    SYSX_ASSERT(merge_range.duration() == t.duration());
-
-    buf_.push_back(merge_range.begin(), merge_range.end());
-    future_.pop_front(merge_range.duration());
+    // absorbed tuples wait for their successor
+    if (!absorb)
+      move_future(t.duration());
   }
 }
 
@@ -121,7 +157,7 @@ timed_stream<T, P>::push(value_type const& val)
     future_.front(tup);
   } else {
     // merge with existing future sequence
-    sequence_type pushed;
+    sequence_type pushed(future_.resource());
     pushed.push_back(tup);
     merge_future(std::move(pushed));
   }
@@ -131,13 +167,37 @@ template<typename T, typename P>
 void
 timed_stream<T, P>::push(time_type offset, tuple_type const& tuple)
 {
-  sequence_type pushed;
-
-  if (offset > duration_type::zero_time)
-    pushed.push_back(empty_policy::empty(offset));
+  if (zero_time_policy::absorb(tuple) &&
+      !impl::merge_allowed<merge_policy>::value)
+    return; // superseded by the successor
 
+  sequence_type pushed(future_.resource());
   pushed.push_back(tuple);
+
+  if (offset == duration_type::zero_time) {
+    merge_future(std::move(pushed));
+    return;
+  }
+
+  // extend the future up to the offset, the gap is not merged
+  duration_type const start = offset;
+  if (future_.duration() < start)
+    future_.push_back(empty_policy::empty(start - future_.duration()));
+
+  // set aside the future before the offset, including the zero-time tuples
+  // at the offset, which precede the pushed tuple, merge it into the rest
+  future_.split(start);
+  sequence_type head(future_.resource());
+  duration_type left = start;
+  while (!future_.empty() && future_.front_duration() <= left) {
+    left -= future_.front_duration();
+    head.push_back(future_.front(), /* join = */ false);
+    future_.pop_front();
+  }
+
   merge_future(std::move(pushed));
+  head.move_back(future_);
+  future_.move_back(head);
 }
 
 /* ------------------------- commit interface ------------------------- */
@@ -167,11 +227,7 @@ timed_stream<T, P>::do_pre_commit_reader(duration_type const& dur)
   future_.split(fdur);
 
   // append from future so we can satisfy the commit
-  auto range = future_.range(fdur);
-
-  buf_.push_back(range.begin(), range.end());
-
-  future_.pop_front(fdur);
+  move_future(fdur);
 }
 
 template<typename T, typename P>
@@ -189,15 +245,11 @@ timed_stream<T, P>::do_commit_reader(timed_reader_base& r,
   bool new_window = reader.buf_.empty();
 
   if (dur == duration()) {
-    if (!last) {
-      reader.buf_.push_back(buf_);
-    } else {
-      reader.buf_.move_back(buf_);
-    }
+    reader.append(buf_, /* move = */ last);
   } else {
     // partially commit, buf_ has already been prepared
     auto range = buf_.range(dur);
-    reader.buf_.push_back(range.begin(), range.end());
+    reader.append(range.begin(), range.end());
 
     if (last)
       buf_.pop_front(dur);
@@ -27,13 +27,13 @@
 
 #include <tvs/tracing/timed_duration.h>
 #include <tvs/tracing/timed_object.h>
+#include <tvs/tracing/timed_reader_base.h> // buffer_policy
 
 #include <vector>
 
 namespace tracing {
 
 // forward declarations
-class timed_reader_base;
 class timed_writer_base;
 
 /// type-independent base class for timed streams
@@ -51,6 +51,16 @@ public:
   void detach(timed_writer_base& writer);
   void detach(timed_reader_base& reader);
 
+  /// readers currently attached to this stream
+  std::vector<timed_reader_base*> const& readers() const { return readers_; }
+
+  /// Limit the buffer of all current and future readers of this stream.
+  ///
+  /// Readers attached later inherit the limit, unless they set their own one
+  /// (see timed_reader_base::set_buffer_limit()).
+  void set_buffer_limit(std::size_t max_tuples,
+                        buffer_policy policy = buffer_policy::drop_oldest);
+
   time_type begin_time() const { return local_time(); }
   time_type end_time() const { return local_time() + duration(); }
   virtual duration_type duration() const = 0;
@@ -80,6 +90,9 @@ private:
 
   timed_writer_base* writer_;
   std::vector<timed_reader_base*> readers_;
+
+  std::size_t buffer_limit_;
+  buffer_policy buffer_policy_;
 }; // class timed_value_base
 
 } // namespace tracing
@@ -26,6 +26,8 @@
 
 #include <tvs/tracing/timed_value.h>
 
+#include <ratio>
+
 namespace tracing {
 
 /* --------------------------- split policies -------------------------- */
@@ -59,6 +61,17 @@ struct timed_merge_policy_override;
 template<typename T>
 struct timed_merge_policy_union;
 
+/* ------------------------- join value policies ----------------------- */
+
+template<typename T>
+struct timed_join_value_hold;
+
+template<typename T>
+struct timed_join_value_average;
+
+template<typename T>
+struct timed_join_value_sum;
+
 /* --------------------------- join policies -------------------------- */
 
 template<typename T>
@@ -67,6 +80,24 @@ struct timed_join_policy_combine;
 template<typename T>
 struct timed_join_policy_separate;
 
+/// join values within an absolute distance of \a Epsilon
+template<typename T,
+         typename Epsilon,
+         typename Value = timed_join_value_hold<T>>
+struct timed_join_policy_absolute;
+
+/// join values within a relative distance of \a Epsilon
+template<typename T,
+         typename Epsilon = std::ratio<1, 1000000>,
+         typename Value = timed_join_value_hold<T>>
+struct timed_join_policy_relative;
+
+/// join values within the same bucket of width \a Quantum
+template<typename T,
+         typename Quantum,
+         typename Value = timed_join_value_hold<T>>
+struct timed_join_policy_quantized;
+
 /* --------------------------- empty policies -------------------------- */
 
 template<typename T>
@@ -25,6 +25,10 @@
 
 #include <tvs/tracing/timed_value.h>
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
 namespace tracing {
 
 /* --------------------------- split policies -------------------------- */
@@ -142,14 +146,58 @@ struct timed_merge_policy_union
   }
 };
 
+/// mean of the overlapping values
+///
+/// The merged parts always have the same duration, such that the mean of two
+/// overlapping pushes is their duration-weighted mean.  The tuples carry no
+/// count of the merged values though: each merge takes the mean of the
+/// existing and the pushed value, i.e. with more than two overlapping pushes,
+/// the earlier values are halved again by every later push and the result
+/// depends on the push order (e.g. 3, 3, 6 yields 4.5 instead of 4).
 template<typename T>
-struct timed_merge_policy_average;
+struct timed_merge_policy_average
+{
+  typedef T value_type;
+  typedef timed_value<T> tuple_type;
+  typedef typename tuple_type::duration_type duration_type;
 
+  static void merge(tuple_type& back, tuple_type const& other)
+  {
+    SYSX_ASSERT(back.duration() == other.duration());
+    back.value((back.value() + other.value()) / 2);
+  }
+};
+
+/// maximum of the overlapping values
 template<typename T>
-struct timed_merge_policy_maximum;
+struct timed_merge_policy_maximum
+{
+  typedef T value_type;
+  typedef timed_value<T> tuple_type;
+  typedef typename tuple_type::duration_type duration_type;
 
+  static void merge(tuple_type& back, tuple_type const& other)
+  {
+    SYSX_ASSERT(back.duration() == other.duration());
+    if (back.value() < other.value())
+      back.value(other.value());
+  }
+};
+
+/// the pushed value replaces the existing value
 template<typename T>
-struct timed_merge_policy_override;
+struct timed_merge_policy_override
+{
+  typedef T value_type;
+  typedef timed_value<T> tuple_type;
+  typedef typename tuple_type::duration_type duration_type;
+
+  static void merge(tuple_type& back, tuple_type const& other)
+  {
+    SYSX_ASSERT(back.duration() == other.duration());
+    back.value(other.value());
+  }
+};
 
 /* --------------------------- join policies -------------------------- */
 
@@ -178,6 +226,181 @@ struct timed_join_policy_separate
   static bool join(tuple_type&, tuple_type const&) { return false; }
 };
 
+/* ------------------------- tolerant join policies -------------------- */
+
+/// keep the value of the first tuple of a join
+///
+/// For intensive values (timed_split_policy_keep), e.g. in state streams.
+template<typename T>
+struct timed_join_value_hold
+{
+  typedef T value_type;
+  typedef timed_value<value_type> tuple_type;
+
+  static const bool extensive = false;
+
+  static double level(tuple_type const& t) { return t.value(); }
+
+  static void join(tuple_type& back, tuple_type const& join)
+  {
+    back.add_duration(join.duration());
+  }
+};
+
+/// duration-weighted average of the joined tuples
+///
+/// For intensive values (timed_split_policy_keep), e.g. in state streams.
+template<typename T>
+struct timed_join_value_average
+{
+  typedef T value_type;
+  typedef timed_value<value_type> tuple_type;
+
+  static const bool extensive = false;
+
+  static double level(tuple_type const& t) { return t.value(); }
+
+  static void join(tuple_type& back, tuple_type const& join)
+  {
+    using utype = sysx::units::time_type;
+
+    if (join.is_infinite()) {
+      back.value(join.value());
+    } else if (!back.is_infinite()) {
+      auto const wb = utype(back.duration()).value();
+      auto const wj = utype(join.duration()).value();
+      if (wb + wj > 0.0)
+        back.value(static_cast<value_type>((back.value() * wb +
+                                            join.value() * wj) /
+                                           (wb + wj)));
+    }
+    back.add_duration(join.duration());
+  }
+};
+
+/// sum of the joined tuples
+///
+/// For extensive values (timed_split_policy_average), e.g. in process streams.
+/// The tolerance applies to the values per second of the tuples.
+template<typename T>
+struct timed_join_value_sum
+{
+  typedef T value_type;
+  typedef timed_value<value_type> tuple_type;
+
+  static const bool extensive = true;
+
+  static double level(tuple_type const& t)
+  {
+    using utype = sysx::units::time_type;
+
+    if (t.is_infinite() || t.duration() == tuple_type::duration_type::zero_time)
+      return t.value();
+    return t.value() / utype(t.duration()).value();
+  }
+
+  static void join(tuple_type& back, tuple_type const& join)
+  {
+    SYSX_ASSERT(!back.is_infinite() && !join.is_infinite());
+    back.value(back.value() + join.value());
+    back.add_duration(join.duration());
+  }
+};
+
+namespace impl {
+
+template<typename Ratio>
+constexpr double
+ratio_value()
+{
+  return static_cast<double>(Ratio::num) / static_cast<double>(Ratio::den);
+}
+
+} // namespace impl
+
+/**
+ * \brief join adjacent tuples with values within an absolute tolerance
+ *
+ * The values of \a back and \a join are joined, if they differ by at most
+ * \a Epsilon (a std::ratio).  The joined value is determined by \a Value,
+ * i.e. the value of the first tuple (timed_join_value_hold) or the
+ * duration-weighted average (timed_join_value_average).  With the average, the
+ * reported value may drift from the first value of a run, but stays within
+ * the range of the joined values.  Extensive values are summed
+ * (timed_join_value_sum) and compared per second.
+ */
+template<typename T, typename Epsilon, typename Value>
+struct timed_join_policy_absolute
+{
+  static_assert(std::is_arithmetic<T>::value,
+                "tolerant join policies require arithmetic values");
+
+  typedef T value_type;
+  typedef timed_value<value_type> tuple_type;
+
+  static bool join(tuple_type& back, tuple_type const& join)
+  {
+    double const d = Value::level(back) - Value::level(join);
+    if (std::abs(d) > impl::ratio_value<Epsilon>())
+      return false;
+    Value::join(back, join);
+    return true;
+  }
+};
+
+/**
+ * \brief join adjacent tuples with values within a relative tolerance
+ *
+ * Like timed_join_policy_absolute, but the tolerance is relative to the
+ * larger magnitude of both values.
+ */
+template<typename T, typename Epsilon, typename Value>
+struct timed_join_policy_relative
+{
+  static_assert(std::is_arithmetic<T>::value,
+                "tolerant join policies require arithmetic values");
+
+  typedef T value_type;
+  typedef timed_value<value_type> tuple_type;
+
+  static bool join(tuple_type& back, tuple_type const& join)
+  {
+    double const a = Value::level(back), b = Value::level(join);
+    double const scale = std::max(std::abs(a), std::abs(b));
+    if (std::abs(a - b) > impl::ratio_value<Epsilon>() * scale)
+      return false;
+    Value::join(back, join);
+    return true;
+  }
+};
+
+/**
+ * \brief join adjacent tuples with values in the same quantization bucket
+ *
+ * The values are divided into buckets [k * Quantum, (k+1) * Quantum), adjacent
+ * tuples within the same bucket are joined.  In contrast to the tolerance
+ * policies, a run of slowly drifting values is split at the bucket bounds.
+ */
+template<typename T, typename Quantum, typename Value>
+struct timed_join_policy_quantized
+{
+  static_assert(std::is_arithmetic<T>::value,
+                "tolerant join policies require arithmetic values");
+
+  typedef T value_type;
+  typedef timed_value<value_type> tuple_type;
+
+  static bool join(tuple_type& back, tuple_type const& join)
+  {
+    double const q = impl::ratio_value<Quantum>();
+    if (std::floor(Value::level(back) / q) !=
+        std::floor(Value::level(join) / q))
+      return false;
+    Value::join(back, join);
+    return true;
+  }
+};
+
 /* --------------------------- empty policies -------------------------- */
 
 template<typename T>
@@ -207,6 +430,103 @@ struct timed_empty_policy_silence
   }
 };
 
+/* ------------------------- zero time policies ------------------------ */
+
+/// store zero-time ("delta") tuples like any other tuple
+template<typename T>
+struct timed_zero_time_policy_keep
+{
+  typedef T value_type;
+  typedef timed_value<value_type> tuple_type;
+
+  static bool absorb(tuple_type const&) { return false; }
+};
+
+/// fold zero-time tuples into their successor
+///
+/// A zero-time tuple is kept in the future of the stream until its successor
+/// is known and merged into it with the merge policy, before both reach the
+/// readers.  The folded value is reported for the duration of the successor,
+/// e.g. the events of a zero-time tuple are reported with the events of the
+/// following tuple.  If the merge policy forbids merging, as in state streams,
+/// the zero-time value is not observable and superseded by the successor.
+template<typename T>
+struct timed_zero_time_policy_absorb
+{
+  typedef T value_type;
+  typedef timed_value<value_type> tuple_type;
+
+  static bool absorb(tuple_type const& t)
+  {
+    return t.duration() == tuple_type::duration_type::zero_time;
+  }
+};
+
+namespace impl {
+
+template<typename>
+struct void_type
+{
+  typedef void type;
+};
+
+/// can tuples be merged with \a MergePolicy?
+template<typename MergePolicy>
+struct merge_allowed : std::true_type
+{};
+
+template<typename T>
+struct merge_allowed<timed_merge_policy_error<T>> : std::false_type
+{};
+
+/// does \a JoinPolicy join the values of \a SplitPolicy consistently, i.e.
+/// extensive values are summed and intensive values are held or averaged?
+template<typename JoinPolicy, typename SplitPolicy>
+struct join_consistent : std::true_type
+{};
+
+template<typename Value, typename SplitPolicy>
+struct join_value_consistent
+  : std::integral_constant<
+      bool,
+      Value::extensive ==
+        std::is_same<SplitPolicy,
+                     timed_split_policy_average<
+                       typename Value::value_type>>::value>
+{};
+
+template<typename T, typename E, typename V, typename S>
+struct join_consistent<timed_join_policy_absolute<T, E, V>, S>
+  : join_value_consistent<V, S>
+{};
+
+template<typename T, typename E, typename V, typename S>
+struct join_consistent<timed_join_policy_relative<T, E, V>, S>
+  : join_value_consistent<V, S>
+{};
+
+template<typename T, typename Q, typename V, typename S>
+struct join_consistent<timed_join_policy_quantized<T, Q, V>, S>
+  : join_value_consistent<V, S>
+{};
+
+/// zero_time_policy of \a Traits, timed_zero_time_policy_keep if not given
+template<typename Traits, typename = void>
+struct zero_time_policy_of
+{
+  typedef timed_zero_time_policy_keep<typename Traits::value_type> type;
+};
+
+template<typename Traits>
+struct zero_time_policy_of<
+  Traits,
+  typename void_type<typename Traits::zero_time_policy>::type>
+{
+  typedef typename Traits::zero_time_policy type;
+};
+
+} // namespace impl
+
 /* --------------------------------------------------------------------- */
 
 } // namespace tracing
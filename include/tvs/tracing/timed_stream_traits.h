@@ -36,6 +36,7 @@ struct timed_process_traits
   typedef timed_split_policy_average<value_type> split_policy;
   typedef timed_join_policy_separate<value_type> join_policy;
   typedef timed_merge_policy_accumulate<value_type> merge_policy;
+  typedef timed_zero_time_policy_keep<value_type> zero_time_policy;
 };
 
 template<typename T>
@@ -46,6 +47,7 @@ struct timed_state_traits
   typedef timed_split_policy_keep<value_type> split_policy;
   typedef timed_join_policy_combine<value_type> join_policy;
   typedef timed_merge_policy_error<value_type> merge_policy;
+  typedef timed_zero_time_policy_keep<value_type> zero_time_policy;
 };
 
 template<typename T>
@@ -56,6 +58,7 @@ struct timed_event_traits
   typedef timed_split_policy_decay<value_type> split_policy;
   typedef timed_join_policy_separate<value_type> join_policy;
   typedef timed_merge_policy_union<value_type> merge_policy;
+  typedef timed_zero_time_policy_keep<value_type> zero_time_policy;
 };
 
 } // namespace tracing
@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_window_view.h
+ * \brief  non-splitting cursors and windows over timed sequences
+ * \see    timed_ranges.h
+ *
+ * In contrast to the ranges of a \ref timed_sequence, a
+ * \ref timed_window_view does not split the tuples at its boundaries.
+ * Partially covered tuples are clipped virtually by applying the split policy
+ * of the sequence when they are read, the underlying sequence is never
+ * modified.
+ */
+
+#ifndef TVS_TIMED_WINDOW_VIEW_H_INCLUDED_
+#define TVS_TIMED_WINDOW_VIEW_H_INCLUDED_
+
+#include <tvs/tracing/timed_sequence.h>
+
+#include <iterator>
+
+namespace tracing {
+
+namespace impl {
+
+/// clip a tuple to its sub-interval [from, to) using a split policy
+template<typename SplitPolicy, typename TupleType, typename DurationType>
+TupleType
+timed_clip(TupleType t, DurationType const& from, DurationType const& to)
+{
+  SYSX_ASSERT(from <= to);
+
+  if (to < t.duration()) // drop the tail
+    t = SplitPolicy::split(t, to);
+  if (from > DurationType::zero_time) { // drop the head
+    SYSX_ASSERT(from < t.duration());
+    SplitPolicy::split(t, from);
+  }
+  return t;
+}
+
+} // namespace impl
+
+/**
+ * \brief read position within a timed_sequence
+ *
+ * The cursor refers to a tuple of the sequence and an offset within this
+ * tuple.  Advancing the cursor never modifies the sequence, the remainder of
+ * a partially passed tuple is computed on demand.  Any modification of the
+ * sequence invalidates the cursor.
+ */
+template<typename T, typename Traits>
+class timed_cursor
+{
+public:
+  typedef timed_sequence<T, Traits> sequence_type;
+  typedef typename sequence_type::const_iterator iterator_type;
+  typedef typename sequence_type::duration_type duration_type;
+  typedef typename sequence_type::tuple_type tuple_type;
+  typedef typename sequence_type::value_type value_type;
+  typedef typename Traits::split_policy split_policy;
+
+  timed_cursor()
+    : it_()
+    , end_()
+    , offset_()
+    , skip_()
+  {}
+
+  explicit timed_cursor(sequence_type const& seq)
+    : it_(seq.begin())
+    , end_(seq.end())
+    , offset_()
+    , skip_()
+  {}
+
+  /// cursor passed the last tuple?
+  bool at_end() const { return it_ == end_; }
+
+  /// position relative to the start of the sequence
+  duration_type offset() const { return offset_; }
+
+  /// remaining duration of the current tuple
+  duration_type remaining() const
+  {
+    SYSX_ASSERT(!at_end());
+    return it_->duration() - skip_;
+  }
+
+  /// remainder of the current tuple
+  tuple_type tuple() const
+  {
+    SYSX_ASSERT(!at_end());
+    return impl::timed_clip<split_policy>(*it_, skip_, it_->duration());
+  }
+
+  /// first \a d of the remainder of the current tuple
+  tuple_type tuple(duration_type const& d) const
+  {
+    auto t = tuple();
+    if (d < t.duration())
+      return split_policy::split(t, d);
+    return t;
+  }
+
+  /// value of the current tuple (split according to the sequence traits)
+  value_type value() const { return tuple().value(); }
+
+  /// move to the next tuple
+  void next()
+  {
+    SYSX_ASSERT(!at_end());
+    offset_ += remaining();
+    skip_ = duration_type();
+    ++it_;
+  }
+
+  /// pass the first \a d of the remainder of the current tuple (cf. tuple(d))
+  /// and move to the next tuple, once it has been passed completely
+  void advance_segment(duration_type const& d)
+  {
+    SYSX_ASSERT(d <= remaining());
+    if (d == remaining()) {
+      next();
+    } else {
+      skip_ += d;
+      offset_ += d;
+    }
+  }
+
+  /// move forward in time, stops in front of zero-time tuples at the target
+  void advance(duration_type d)
+  {
+    while (!at_end() && d > duration_type::zero_time && d >= remaining()) {
+      d -= remaining();
+      next();
+    }
+    if (d > duration_type::zero_time) {
+      SYSX_ASSERT(!at_end() && "advancing beyond the end of the sequence");
+      skip_ += d;
+      offset_ += d;
+    }
+  }
+
+  /// underlying position and offset within the current tuple
+  iterator_type position() const { return it_; }
+  duration_type skipped() const { return skip_; }
+
+private:
+  iterator_type it_;
+  iterator_type end_;
+  duration_type offset_;
+  duration_type skip_;
+};
+
+/**
+ * \brief read-only window [from, to) of a timed_sequence
+ *
+ * The window covers all tuples overlapping the interval and the zero-time
+ * tuples at its start (and inside), zero-time tuples at \a to belong to the
+ * subsequent window.  The first and the last tuple are clipped to the window
+ * boundaries when dereferenced.  Any modification of the sequence invalidates
+ * the view.
+ */
+template<typename T, typename Traits>
+class timed_window_view
+{
+public:
+  typedef timed_window_view this_type;
+  typedef timed_cursor<T, Traits> cursor_type;
+  typedef typename cursor_type::sequence_type sequence_type;
+  typedef typename cursor_type::iterator_type iterator_type;
+  typedef typename cursor_type::duration_type duration_type;
+  typedef typename cursor_type::tuple_type tuple_type;
+  typedef typename cursor_type::value_type value_type;
+  typedef typename cursor_type::split_policy split_policy;
+  typedef typename sequence_type::size_type size_type;
+
+  /// forward iterator over the (clipped) tuples of the window
+  class const_iterator
+  {
+    friend class timed_window_view;
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef tuple_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef tuple_type const* pointer;
+    typedef tuple_type const& reference;
+
+    const_iterator()
+      : view_()
+      , it_()
+      , start_()
+      , cur_()
+    {}
+
+    reference operator*() const { return cur_; }
+    pointer operator->() const { return &cur_; }
+
+    const_iterator& operator++()
+    {
+      start_ += it_->duration();
+      ++it_;
+      clip();
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    /// start of the (unclipped) tuple relative to the sequence
+    duration_type tuple_offset() const { return start_; }
+
+    friend bool operator==(const_iterator const& a, const_iterator const& b)
+    {
+      return a.it_ == b.it_;
+    }
+    friend bool operator!=(const_iterator const& a, const_iterator const& b)
+    {
+      return !(a == b);
+    }
+
+  private:
+    const_iterator(this_type const* view,
+                   iterator_type it,
+                   duration_type const& start)
+      : view_(view)
+      , it_(it)
+      , start_(start)
+      , cur_()
+    {
+      clip();
+    }
+
+    void clip()
+    {
+      if (it_ == view_->end_)
+        return;
+
+      duration_type from, to = it_->duration();
+      if (view_->from_ > start_)
+        from = view_->from_ - start_;
+      if (!view_->to_.is_infinite() && start_ + to > view_->to_)
+        to = view_->to_ - start_;
+      cur_ = impl::timed_clip<split_policy>(*it_, from, to);
+    }
+
+    this_type const* view_;
+    iterator_type it_;
+    duration_type start_;
+    tuple_type cur_;
+  };
+
+  timed_window_view(sequence_type const& seq,
+                    duration_type const& from,
+                    duration_type const& to)
+    : from_(from)
+    , to_(to)
+    , begin_()
+    , end_()
+    , start_()
+  {
+    SYSX_ASSERT(from <= to);
+
+    // empty window, zero-time tuples at \a to belong to the next window
+    if (from == to || from >= seq.duration()) {
+      begin_ = end_ = seq.end();
+      start_ = seq.duration();
+      return;
+    }
+
+    cursor_type cur(seq);
+    cur.advance(from);
+    begin_ = cur.position();
+    start_ = cur.offset() - cur.skipped();
+
+    // find the first tuple starting at (or after) the end of the window
+    end_ = begin_;
+    for (duration_type t = start_; end_ != seq.end() && t < to; ++end_)
+      t += end_->duration();
+  }
+
+  /// start of the window relative to the sequence
+  duration_type offset() const { return from_; }
+
+  /// covered duration (shorter than requested at the end of the sequence)
+  duration_type duration() const
+  {
+    if (empty())
+      return duration_type();
+    duration_type end = start_;
+    for (auto it = begin_; it != end_; ++it)
+      end += it->duration();
+    return (end < to_ ? end : to_) - from_;
+  }
+
+  bool empty() const { return begin_ == end_; }
+  size_type size() const { return end_ - begin_; }
+
+  const_iterator begin() const { return const_iterator(this, begin_, start_); }
+  const_iterator end() const { return const_iterator(this, end_, start_); }
+
+  tuple_type front() const
+  {
+    SYSX_ASSERT(!empty());
+    return *begin();
+  }
+
+private:
+  duration_type from_;
+  duration_type to_;
+  iterator_type begin_;
+  iterator_type end_;
+  duration_type start_; ///< offset of the first (unclipped) tuple
+};
+
+} // namespace tracing
+
+#endif /* TVS_TIMED_WINDOW_VIEW_H_INCLUDED_ */
+/* Taf!
+ */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   kahan_sum.h
+ * \brief  compensated floating-point summation
+ */
+
+#ifndef SYSX_UTILS_KAHAN_SUM_H_INCLUDED_
+#define SYSX_UTILS_KAHAN_SUM_H_INCLUDED_
+
+namespace sysx {
+namespace utils {
+
+/// compensated (Kahan) summation
+class kahan_sum
+{
+public:
+  kahan_sum()
+    : sum_()
+    , comp_()
+  {}
+
+  void add(double v)
+  {
+    double y = v - comp_;
+    double t = sum_ + y;
+    comp_ = (t - sum_) - y;
+    sum_ = t;
+  }
+
+  double value() const { return sum_; }
+
+  void reset() { sum_ = comp_ = 0.0; }
+
+private:
+  double sum_;
+  double comp_;
+};
+
+} // namespace utils
+} // namespace sysx
+
+#endif /* SYSX_UTILS_KAHAN_SUM_H_INCLUDED_ */
+/* Taf!
+ */
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   memory_resource.h
+ * \brief  polymorphic memory resources and allocators
+ *
+ * A minimal C++14 counterpart of \c std::pmr: \ref memory_resource is the
+ * abstract allocation interface, \ref polymorphic_allocator adapts it to
+ * standard containers.  The buffers of streams, readers and sequences obtain
+ * their memory from the resource that is current (see
+ * \ref memory_resource_scope) when they are created.
+ */
+
+#ifndef SYSX_UTILS_MEMORY_RESOURCE_H_INCLUDED_
+#define SYSX_UTILS_MEMORY_RESOURCE_H_INCLUDED_
+
+#include <tvs/utils/assert.h>
+#include <tvs/utils/noncopyable.h>
+#include <tvs/utils/report.h>
+
+#include <cstddef>
+#include <mutex>
+
+namespace sysx {
+namespace utils {
+
+/// abstract interface for (de-)allocating raw memory
+class memory_resource
+{
+public:
+  typedef std::size_t size_type;
+
+  static const size_type max_align = alignof(std::max_align_t);
+
+  virtual ~memory_resource() = default;
+
+  void* allocate(size_type bytes, size_type align = max_align)
+  {
+    return do_allocate(bytes, align);
+  }
+
+  void deallocate(void* p, size_type bytes, size_type align = max_align)
+  {
+    do_deallocate(p, bytes, align);
+  }
+
+  /// can memory allocated from \a that be deallocated by this resource?
+  bool is_equal(memory_resource const& that) const noexcept
+  {
+    return this == &that || do_is_equal(that);
+  }
+
+protected:
+  virtual void* do_allocate(size_type bytes, size_type align) = 0;
+  virtual void do_deallocate(void* p, size_type bytes, size_type align) = 0;
+  virtual bool do_is_equal(memory_resource const&) const noexcept
+  {
+    return false;
+  }
+};
+
+inline bool
+operator==(memory_resource const& a, memory_resource const& b) noexcept
+{
+  return a.is_equal(b);
+}
+
+inline bool
+operator!=(memory_resource const& a, memory_resource const& b) noexcept
+{
+  return !(a == b);
+}
+
+/// resource using the global operator new/delete
+memory_resource*
+new_delete_resource() noexcept;
+
+/// resource of the calling thread used for new containers
+memory_resource*
+get_default_resource() noexcept;
+
+/// set the default resource of the calling thread, returns the previous one
+/// (\c nullptr restores the new_delete_resource())
+memory_resource*
+set_default_resource(memory_resource*) noexcept;
+
+/**
+ * \brief make a resource the default of the calling thread for a scope
+ *
+ * All streams, readers and processors created within the scope allocate
+ * their buffers from the given resource, which therefore has to outlive
+ * them.  This allows to bind the memory of a simulation instance to a single
+ * resource:
+ * \code
+ * sysx::utils::monotonic_buffer_resource arena;
+ * {
+ *   sysx::utils::memory_resource_scope scope(arena);
+ *   // create the streams and processors of the model
+ * }
+ * \endcode
+ */
+class memory_resource_scope : private noncopyable
+{
+public:
+  explicit memory_resource_scope(memory_resource& r)
+    : prev_(set_default_resource(&r))
+  {}
+
+  ~memory_resource_scope() { set_default_resource(prev_); }
+
+private:
+  memory_resource* prev_;
+};
+
+/**
+ * \brief resource releasing its memory only as a whole
+ *
+ * Allocations are served from chunks of geometrically growing size obtained
+ * from an upstream resource, deallocation is a no-op.  All memory is returned
+ * on release() or destruction.
+ *
+ * The resource is synchronised, since independent parts of the stream graph
+ * may be committed concurrently (see set_sync_concurrency()).
+ */
+class monotonic_buffer_resource
+  : public memory_resource
+  , private noncopyable
+{
+public:
+  explicit monotonic_buffer_resource(
+    size_type initial_size = 4096,
+    memory_resource* upstream = get_default_resource());
+
+  ~monotonic_buffer_resource() override;
+
+  /// return all chunks to the upstream resource
+  void release();
+
+  memory_resource* upstream_resource() const { return upstream_; }
+
+  /// bytes requested since the last release()
+  size_type bytes_allocated() const;
+  /// bytes currently obtained from the upstream resource
+  size_type bytes_reserved() const;
+
+protected:
+  void* do_allocate(size_type bytes, size_type align) override;
+  void do_deallocate(void*, size_type, size_type) override {}
+
+private:
+  struct chunk;
+
+  mutable std::mutex mutex_;
+  memory_resource* upstream_;
+  chunk* chunks_;
+  char* cur_;
+  size_type left_;
+  size_type next_size_;
+  size_type allocated_;
+  size_type reserved_;
+};
+
+/**
+ * \brief resource recycling blocks of equal size
+ *
+ * Requests up to \ref max_block_size bytes are rounded up to a power of two
+ * and served from per-size free lists, larger requests are forwarded to the
+ * upstream resource.  All memory (including outstanding large blocks) is
+ * returned on release() or destruction.
+ *
+ * The resource is synchronised, see \ref monotonic_buffer_resource.
+ */
+class pool_resource
+  : public memory_resource
+  , private noncopyable
+{
+public:
+  static const size_type min_block_size = 16;
+  static const size_type max_block_size = 4096;
+
+  explicit pool_resource(memory_resource* upstream = get_default_resource());
+
+  ~pool_resource() override;
+
+  /// return all memory to the upstream resource
+  void release();
+
+  memory_resource* upstream_resource() const { return upstream_; }
+
+  /// bytes currently handed out to users
+  size_type bytes_in_use() const;
+  /// maximum of bytes_in_use() since the last release()
+  size_type peak_bytes_in_use() const;
+
+protected:
+  void* do_allocate(size_type bytes, size_type align) override;
+  void do_deallocate(void* p, size_type bytes, size_type align) override;
+
+private:
+  struct block;
+  struct chunk;
+  struct large_block;
+
+  static const size_type num_pools = 9; // 16 .. 4096
+
+  static size_type pool_index(size_type bytes);
+
+  mutable std::mutex mutex_;
+  memory_resource* upstream_;
+  block* free_[num_pools];
+  chunk* chunks_;
+  large_block* large_;
+  size_type in_use_;
+  size_type peak_;
+};
+
+/**
+ * \brief standard allocator drawing from a memory_resource
+ *
+ * Default constructed allocators use the current default resource of the
+ * calling thread.  Like \c std::pmr::polymorphic_allocator, the resource is
+ * not propagated on container copy, move or swap.
+ */
+template<typename T>
+class polymorphic_allocator
+{
+  template<typename U>
+  friend class polymorphic_allocator;
+
+public:
+  typedef T value_type;
+
+  polymorphic_allocator() noexcept
+    : res_(get_default_resource())
+  {}
+
+  polymorphic_allocator(memory_resource* r) noexcept
+    : res_(r)
+  {
+    SYSX_ASSERT(r != nullptr);
+  }
+
+  template<typename U>
+  polymorphic_allocator(polymorphic_allocator<U> const& that) noexcept
+    : res_(that.res_)
+  {}
+
+  polymorphic_allocator& operator=(polymorphic_allocator const&) = delete;
+  polymorphic_allocator(polymorphic_allocator const&) = default;
+
+  T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(res_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    res_->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  polymorphic_allocator select_on_container_copy_construction() const
+  {
+    return polymorphic_allocator();
+  }
+
+  memory_resource* resource() const { return res_; }
+
+private:
+  memory_resource* res_;
+};
+
+template<typename T, typename U>
+bool
+operator==(polymorphic_allocator<T> const& a,
+           polymorphic_allocator<U> const& b) noexcept
+{
+  return *a.resource() == *b.resource();
+}
+
+template<typename T, typename U>
+bool
+operator!=(polymorphic_allocator<T> const& a,
+           polymorphic_allocator<U> const& b) noexcept
+{
+  return !(a == b);
+}
+
+} // namespace utils
+} // namespace sysx
+
+#endif /* SYSX_UTILS_MEMORY_RESOURCE_H_INCLUDED_ */
+/* Taf!
+ */
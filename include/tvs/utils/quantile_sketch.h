@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   quantile_sketch.h
+ * \brief  mergeable sketch for weighted quantiles
+ */
+
+#ifndef SYSX_UTILS_QUANTILE_SKETCH_H_INCLUDED_
+#define SYSX_UTILS_QUANTILE_SKETCH_H_INCLUDED_
+
+#include <cstddef>
+#include <map>
+
+namespace sysx {
+namespace utils {
+
+/**
+ * \brief weighted quantiles with a bounded relative error
+ *
+ * Values are counted in logarithmically spaced buckets, such that each
+ * reported quantile is within the given relative accuracy of a value of the
+ * exact quantile (cf. DDSketch).  The size of the sketch only depends on the
+ * range of the values, and sketches of the same accuracy can be merged.
+ */
+class quantile_sketch
+{
+public:
+  explicit quantile_sketch(double relative_accuracy = 0.01);
+
+  /// add \a value with the given (positive) weight
+  void add(double value, double weight = 1.0);
+
+  /// add all values of \a that (of the same accuracy)
+  void merge(quantile_sketch const& that);
+
+  /// remove the values of \a that, which have been merged before
+  ///
+  /// Each bucket counts the values added to it, a bucket is removed once all
+  /// of its values have been subtracted again, such that the size of a running
+  /// sketch (e.g. over a sliding window) remains bounded.  The weights are not
+  /// compared, i.e. rounding of the weights does not drop a bucket early.
+  void subtract(quantile_sketch const& that);
+
+  /// approximate \a q-quantile, \a q in [0, 1]
+  double quantile(double q) const;
+
+  double weight() const { return weight_; }
+  /// number of non-empty buckets (excluding zero)
+  std::size_t buckets() const { return positive_.size() + negative_.size(); }
+  bool empty() const { return weight_ <= 0.0; }
+  double relative_accuracy() const { return accuracy_; }
+
+  void clear();
+
+private:
+  int index(double magnitude) const;
+  double bucket_value(int index) const;
+
+  double accuracy_;
+  double gamma_;
+  double log_gamma_;
+
+  struct bucket
+  {
+    double weight = 0.0;
+    std::size_t count = 0; ///< number of added values
+  };
+  typedef std::map<int, bucket> bucket_map;
+
+  static void merge_buckets(bucket_map&, bucket_map const&);
+  static void subtract_bucket(bucket&, bucket const&);
+  static void subtract_buckets(bucket_map&, bucket_map const&);
+
+  bucket_map positive_;
+  bucket_map negative_;
+  bucket zero_;
+  double weight_;
+};
+
+} // namespace utils
+} // namespace sysx
+
+#endif /* SYSX_UTILS_QUANTILE_SKETCH_H_INCLUDED_ */
+/* Taf!
+ */
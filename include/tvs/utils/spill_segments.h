@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   spill_segments.h
+ * \brief  FIFO storage in memory-mapped temporary files
+ */
+
+#ifndef SYSX_UTILS_SPILL_SEGMENTS_H_INCLUDED_
+#define SYSX_UTILS_SPILL_SEGMENTS_H_INCLUDED_
+
+#include <tvs/utils/noncopyable.h>
+
+#include <cstddef>
+#include <deque>
+#include <new>
+
+namespace sysx {
+namespace utils {
+
+/**
+ * \brief FIFO of fixed-size records in memory-mapped temporary files
+ *
+ * Records are appended to the last segment, a new segment (an unlinked
+ * temporary file) is created on demand.  A segment is unmapped and its disk
+ * space is released as soon as all of its records have been removed.
+ *
+ * Temporary files are created in the directory given by the environment
+ * variable \c TVS_SPILL_DIR, \c TMPDIR or \c /tmp.  Platforms without
+ * POSIX file mappings fall back to heap allocated segments.
+ */
+class spill_segments : private noncopyable
+{
+public:
+  typedef std::size_t size_type;
+
+  /// default size of a segment in bytes
+  static const size_type default_segment_size = size_type(1) << 20;
+
+  explicit spill_segments(size_type record_size,
+                          size_type record_align = alignof(std::max_align_t),
+                          size_type segment_size = default_segment_size);
+  ~spill_segments();
+
+  /// storage for a new record at the back
+  void* push_back();
+  /// remove the front record, releases its segment if no records are left
+  void pop_front();
+
+  void* front();
+  void const* front() const;
+
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  /// number of currently allocated segments
+  size_type segments() const { return segments_.size(); }
+
+private:
+  struct segment
+  {
+    char* data;
+    int fd;
+  };
+
+  segment allocate();
+  void release(segment&);
+
+  size_type record_size_;
+  size_type records_per_segment_;
+  size_type head_; ///< index of the front record in the first segment
+  size_type tail_; ///< number of records in the last segment
+  size_type size_;
+  std::deque<segment> segments_;
+};
+
+/// typed FIFO based on spill_segments
+/**
+ * The stored objects are only valid within the current process, as the
+ * segments are never shared with other processes.  Values should therefore
+ * not own any additional (heap) memory to be effectively spilled.
+ */
+template<typename T>
+class spill_queue : private noncopyable
+{
+public:
+  typedef T value_type;
+  typedef spill_segments::size_type size_type;
+
+  explicit spill_queue(
+    size_type segment_size = spill_segments::default_segment_size)
+    : segments_(sizeof(T), alignof(T), segment_size)
+  {}
+
+  ~spill_queue()
+  {
+    while (!empty())
+      pop_front();
+  }
+
+  void push_back(value_type const& v) { new (segments_.push_back()) T(v); }
+
+  void pop_front()
+  {
+    front().~T();
+    segments_.pop_front();
+  }
+
+  value_type& front() { return *static_cast<T*>(segments_.front()); }
+  value_type const& front() const
+  {
+    return *static_cast<T const*>(segments_.front());
+  }
+
+  size_type size() const { return segments_.size(); }
+  bool empty() const { return segments_.empty(); }
+  size_type segments() const { return segments_.segments(); }
+
+private:
+  spill_segments segments_;
+};
+
+} // namespace utils
+} // namespace sysx
+
+#endif /* SYSX_UTILS_SPILL_SEGMENTS_H_INCLUDED_ */
+/* Taf!
+ * :tag: (utils,h)
+ */
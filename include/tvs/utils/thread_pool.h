@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   thread_pool.h
+ * \brief  simple work-stealing thread pool
+ */
+
+#ifndef SYSX_UTILS_THREAD_POOL_H_INCLUDED_
+#define SYSX_UTILS_THREAD_POOL_H_INCLUDED_
+
+#include <tvs/utils/noncopyable.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sysx {
+namespace utils {
+
+/**
+ * \brief work-stealing thread pool for batches of independent tasks
+ *
+ * Each thread owns a task queue.  The tasks of a batch are distributed
+ * round-robin among the queues.  Threads run tasks from the back of their own
+ * queue and steal from the front of the other queues once their own queue is
+ * empty.  The calling thread participates in processing the batch.
+ */
+class thread_pool : private noncopyable
+{
+public:
+  typedef std::function<void()> task_type;
+
+  /// create a pool with the given number of additional worker threads
+  explicit thread_pool(unsigned num_workers);
+  ~thread_pool();
+
+  /// number of worker threads (excluding the calling thread)
+  unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+  /// run all tasks and block until they are completed
+  /**
+   * The first exception thrown by any of the tasks is rethrown in the calling
+   * thread after the batch has been completed.
+   */
+  void run(std::vector<task_type>& tasks);
+
+private:
+  struct queue_type
+  {
+    std::mutex mutex;
+    std::deque<task_type*> tasks;
+  };
+
+  void work(std::size_t idx);
+  bool try_acquire(std::size_t idx, task_type*& task);
+  void execute(task_type& task);
+
+  std::vector<std::unique_ptr<queue_type>> queues_;
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+
+  std::atomic<std::size_t> queued_;
+  std::size_t pending_;
+  std::exception_ptr error_;
+  bool stop_;
+};
+
+} // namespace utils
+} // namespace sysx
+
+#endif /* SYSX_UTILS_THREAD_POOL_H_INCLUDED_ */
+/* Taf!
+ * :tag: (utils,h)
+ */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   notify_worklist.h
+ * \brief  deferred listener notifications (library internal)
+ * \see    timed_object.cpp, set_notify_mode()
+ */
+
+#ifndef TVS_TRACING_NOTIFY_WORKLIST_H_INCLUDED_
+#define TVS_TRACING_NOTIFY_WORKLIST_H_INCLUDED_
+
+#include "tvs/utils/noncopyable.h"
+
+namespace tracing {
+
+class timed_reader_base;
+
+namespace impl {
+
+/// Scope of a stream commit on the calling thread.
+///
+/// In notify_mode::deferred, the queued notifications are dispatched by an
+/// explicit call to dispatch() at the end of the outermost batch of the
+/// calling thread.  sync() spans a single batch over the commits of all
+/// streams in the scope and dispatches rank by rank.  The destructor only
+/// leaves the batch, so that errors raised by a listener propagate to the
+/// caller of the commit.  The notifications still queued by an aborted commit
+/// are dropped.
+class notify_batch : private sysx::utils::noncopyable
+{
+public:
+  notify_batch();
+  ~notify_batch();
+
+  /// dispatch the queued notifications, if this is the outermost batch
+  void dispatch();
+
+  /// dispatch the queued notifications of the listeners below \a rank
+  /// (see update_stream_ranks()), if this is the outermost batch
+  void dispatch_below(unsigned rank);
+
+private:
+  bool dispatching_ = false;
+};
+
+/// queue the notification of the reader's listener, returns false if the
+/// listener has to be notified immediately
+bool
+defer_notify(timed_reader_base& reader);
+
+/// drop a queued notification (e.g. on destruction of the reader)
+void
+cancel_notify(timed_reader_base& reader);
+
+/// invalidate the cached stream graph (streams, readers or listeners changed)
+void
+graph_changed();
+
+} // namespace impl
+} // namespace tracing
+
+#endif /* TVS_TRACING_NOTIFY_WORKLIST_H_INCLUDED_ */
+/* Taf!
+ */
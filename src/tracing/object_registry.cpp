@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   object_registry.cpp
+ * \brief  interned names and hashed name registries (implementation)
+ * \see    object_registry.h
+ */
+
+#include "object_registry.h"
+
+#include "tvs/utils/assert.h"
+#include "tvs/utils/report.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace tracing {
+namespace impl {
+
+namespace {
+
+/// initial number of slots (power of two)
+const std::size_t initial_slots = 64;
+
+/// size of the character blocks of the name arena
+const std::size_t block_size = 16 * 1024;
+
+/// FNV-1a
+std::size_t
+hash_name(const char* name, std::size_t len)
+{
+  std::uint64_t h = 14695981039346656037ull;
+  for (std::size_t i = 0; i < len; ++i) {
+    h ^= static_cast<unsigned char>(name[i]);
+    h *= 1099511628211ull;
+  }
+  return static_cast<std::size_t>(h);
+}
+
+/// keep the load factor below 3/4
+bool
+needs_growth(std::size_t used, std::size_t slots)
+{
+  return (used + 1) * 4 > slots * 3;
+}
+
+} // anonymous namespace
+
+/* ----------------------------- name_arena --------------------------- */
+
+name_arena::name_arena()
+  : slots_(initial_slots, slot_type{ nullptr, 0 })
+  , size_()
+  , blocks_()
+  , block_pos_()
+  , block_left_()
+{}
+
+const char*
+name_arena::intern(const char* name)
+{
+  return intern(name, std::strlen(name));
+}
+
+const char*
+name_arena::intern(const char* name, std::size_t len)
+{
+  if (needs_growth(size_, slots_.size()))
+    grow();
+
+  auto hash = hash_name(name, len);
+  auto& slot = slots_[probe(name, len, hash)];
+  if (slot.name == nullptr) {
+    slot.name = store(name, len);
+    slot.hash = hash;
+    ++size_;
+  }
+  return slot.name;
+}
+
+const char*
+name_arena::find(const char* name) const
+{
+  return find(name, std::strlen(name));
+}
+
+const char*
+name_arena::find(const char* name, std::size_t len) const
+{
+  return slots_[probe(name, len, hash_name(name, len))].name;
+}
+
+std::size_t
+name_arena::probe(const char* name, std::size_t len, std::size_t hash) const
+{
+  auto const mask = slots_.size() - 1;
+  auto idx = hash & mask;
+  for (;;) {
+    auto const& slot = slots_[idx];
+    if (slot.name == nullptr ||
+        (slot.hash == hash && std::strncmp(slot.name, name, len) == 0 &&
+         slot.name[len] == '\0'))
+      return idx;
+    idx = (idx + 1) & mask;
+  }
+}
+
+const char*
+name_arena::store(const char* name, std::size_t len)
+{
+  // oversized names get a block of their own
+  if (len + 1 > block_left_) {
+    auto size = std::max(block_size, len + 1);
+    blocks_.emplace_back(new char[size]);
+    block_pos_ = blocks_.back().get();
+    block_left_ = size;
+  }
+
+  char* ret = block_pos_;
+  std::memcpy(ret, name, len);
+  ret[len] = '\0';
+
+  block_pos_ += len + 1;
+  block_left_ -= len + 1;
+  return ret;
+}
+
+void
+name_arena::grow()
+{
+  std::vector<slot_type> old(slots_.size() * 2, slot_type{ nullptr, 0 });
+  old.swap(slots_);
+
+  auto const mask = slots_.size() - 1;
+  for (auto const& slot : old) {
+    if (slot.name == nullptr)
+      continue;
+    auto idx = slot.hash & mask;
+    while (slots_[idx].name != nullptr)
+      idx = (idx + 1) & mask;
+    slots_[idx] = slot;
+  }
+}
+
+/* ---------------------------- name_map_base -------------------------- */
+
+name_map_base::name_map_base()
+  : slots_(initial_slots, slot_type{ nullptr, nullptr })
+  , used_()
+{}
+
+const char*
+name_map_base::tombstone()
+{
+  static const char marker = '\0';
+  return &marker;
+}
+
+std::size_t
+name_map_base::hash(const char* key)
+{
+  // Fibonacci hashing of the (interned) address
+  auto h = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key));
+  h *= 11400714819323198485ull;
+  return static_cast<std::size_t>(h >> 32);
+}
+
+void*
+name_map_base::find_ptr(const char* interned) const
+{
+  if (interned == nullptr)
+    return nullptr;
+
+  auto const mask = slots_.size() - 1;
+  for (auto idx = hash(interned) & mask;; idx = (idx + 1) & mask) {
+    auto const& slot = slots_[idx];
+    if (slot.key == interned)
+      return slot.value;
+    if (slot.key == nullptr)
+      return nullptr;
+  }
+}
+
+bool
+name_map_base::insert_ptr(const char* interned, void* value)
+{
+  SYSX_ASSERT(interned != nullptr);
+
+  if (needs_growth(used_, slots_.size()))
+    grow();
+
+  auto const mask = slots_.size() - 1;
+  slot_type* reuse = nullptr;
+  for (auto idx = hash(interned) & mask;; idx = (idx + 1) & mask) {
+    auto& slot = slots_[idx];
+    if (slot.key == interned)
+      return false;
+
+    if (slot.key == tombstone()) {
+      if (reuse == nullptr)
+        reuse = &slot;
+    } else if (slot.key == nullptr) {
+      if (reuse == nullptr) {
+        reuse = &slot;
+        ++used_;
+      }
+      break;
+    }
+  }
+
+  reuse->key = interned;
+  reuse->value = value;
+  return true;
+}
+
+bool
+name_map_base::erase_ptr(const char* interned)
+{
+  if (interned == nullptr)
+    return false;
+
+  auto const mask = slots_.size() - 1;
+  for (auto idx = hash(interned) & mask;; idx = (idx + 1) & mask) {
+    auto& slot = slots_[idx];
+    if (slot.key == interned) {
+      slot.key = tombstone();
+      slot.value = nullptr;
+      return true;
+    }
+    if (slot.key == nullptr)
+      return false;
+  }
+}
+
+void
+name_map_base::grow()
+{
+  // count live entries to decide whether to rehash in place or grow
+  std::size_t live = 0;
+  for (auto const& slot : slots_)
+    live += (slot.key != nullptr && slot.key != tombstone());
+
+  auto size = slots_.size();
+  if (needs_growth(live * 2, size))
+    size *= 2;
+
+  std::vector<slot_type> old(size, slot_type{ nullptr, nullptr });
+  old.swap(slots_);
+  used_ = 0;
+
+  auto const mask = slots_.size() - 1;
+  for (auto const& slot : old) {
+    if (slot.key == nullptr || slot.key == tombstone())
+      continue;
+    auto idx = hash(slot.key) & mask;
+    while (slots_[idx].key != nullptr)
+      idx = (idx + 1) & mask;
+    slots_[idx] = slot;
+    ++used_;
+  }
+}
+
+} // namespace impl
+} // namespace tracing
+
+/* Taf!
+ */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   object_registry.h
+ * \brief  interned names and hashed name registries (library internal)
+ * \see    timed_object.cpp
+ */
+
+#ifndef TVS_TRACING_OBJECT_REGISTRY_H_INCLUDED_
+#define TVS_TRACING_OBJECT_REGISTRY_H_INCLUDED_
+
+#include "tvs/utils/noncopyable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace tracing {
+namespace impl {
+
+/**
+ * \brief arena of interned, immutable names
+ *
+ * Each distinct name is stored exactly once in large character blocks, which
+ * are never moved or freed.  The returned pointers therefore stay valid for
+ * the lifetime of the program and equal names share the same pointer.
+ */
+class name_arena : private sysx::utils::noncopyable
+{
+public:
+  name_arena();
+
+  /// return the interned copy of the given name, adding it if necessary
+  const char* intern(const char* name);
+  const char* intern(const char* name, std::size_t len);
+
+  /// return the interned copy of the given name, nullptr if unknown
+  const char* find(const char* name) const;
+  const char* find(const char* name, std::size_t len) const;
+
+  std::size_t size() const { return size_; }
+
+private:
+  struct slot_type
+  {
+    const char* name;
+    std::size_t hash;
+  };
+
+  std::size_t probe(const char* name, std::size_t len, std::size_t hash) const;
+  const char* store(const char* name, std::size_t len);
+  void grow();
+
+  std::vector<slot_type> slots_;
+  std::size_t size_;
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* block_pos_;
+  std::size_t block_left_;
+};
+
+/**
+ * \brief open-addressing hash map from interned names to objects
+ *
+ * Keys are compared by their (interned) address, lookups of arbitrary strings
+ * go through name_arena::find() first.  Erased entries leave tombstones, which
+ * are reused by later insertions and dropped on rehashing.
+ */
+class name_map_base : private sysx::utils::noncopyable
+{
+protected:
+  name_map_base();
+
+  void* find_ptr(const char* interned) const;
+  bool insert_ptr(const char* interned, void* value);
+  bool erase_ptr(const char* interned);
+
+private:
+  struct slot_type
+  {
+    const char* key;
+    void* value;
+  };
+
+  static const char* tombstone();
+  static std::size_t hash(const char* key);
+
+  void grow();
+
+  std::vector<slot_type> slots_;
+  std::size_t used_; // including tombstones
+};
+
+template<typename T>
+class name_map : public name_map_base
+{
+public:
+  /// lookup by interned name
+  T* find(const char* interned) const
+  {
+    return static_cast<T*>(find_ptr(interned));
+  }
+
+  /// insert by interned name, returns false if the name already exists
+  bool insert(const char* interned, T* value)
+  {
+    return insert_ptr(interned, value);
+  }
+
+  /// erase by interned name, returns false if the name does not exist
+  bool erase(const char* interned) { return erase_ptr(interned); }
+};
+
+} // namespace impl
+} // namespace tracing
+
+#endif /* TVS_TRACING_OBJECT_REGISTRY_H_INCLUDED_ */
+/* Taf!
+ */
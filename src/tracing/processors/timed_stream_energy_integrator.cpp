@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_stream_energy_integrator.cpp
+ * \brief  integration of power streams to energy (implementation)
+ * \see    timed_stream_energy_integrator.h
+ */
+
+#include "tvs/tracing/processors/timed_stream_energy_integrator.h"
+
+#include "tvs/utils/assert.h"
+
+#include <algorithm>
+
+namespace tracing {
+
+timed_stream_energy_integrator::timed_stream_energy_integrator(
+  duration_type const& window)
+  : window_(window)
+  , window_pos_()
+  , emitted_until_()
+{
+  SYSX_ASSERT(!window_.is_infinite());
+}
+
+void
+timed_stream_energy_integrator::in(power_stream_type& stream)
+{
+  power_readers_.push_back(base_type::in(stream));
+}
+
+void
+timed_stream_energy_integrator::in(power_stream_type::writer_type& writer)
+{
+  auto stream = dynamic_cast<power_stream_type*>(&writer.stream());
+  SYSX_ASSERT(stream != nullptr);
+  in(*stream);
+}
+
+void
+timed_stream_energy_integrator::in(energy_stream_type& stream)
+{
+  energy_readers_.push_back(base_type::in(stream));
+}
+
+void
+timed_stream_energy_integrator::in(energy_stream_type::writer_type& writer)
+{
+  auto stream = dynamic_cast<energy_stream_type*>(&writer.stream());
+  SYSX_ASSERT(stream != nullptr);
+  in(*stream);
+}
+
+void
+timed_stream_energy_integrator::energy_out(energy_stream_type& stream)
+{
+  SYSX_ASSERT(!energy_ && "energy output already bound");
+  energy_ = base_type::out(stream);
+}
+
+void
+timed_stream_energy_integrator::cumulative_out(cumulative_stream_type& stream)
+{
+  SYSX_ASSERT(!cumulative_ && "cumulative output already bound");
+  cumulative_ = base_type::out(stream);
+}
+
+timed_stream_energy_integrator::energy_type
+timed_stream_energy_integrator::energy() const
+{
+  return total_.value() * sysx::si::joules;
+}
+
+timed_stream_energy_integrator::energy_type
+timed_stream_energy_integrator::window_energy() const
+{
+  return current_.value() * sysx::si::joules;
+}
+
+timed_stream_energy_integrator::duration_type
+timed_stream_energy_integrator::process(duration_type)
+{
+  power_cursors_.clear();
+  for (auto const& rd : power_readers_)
+    power_cursors_.push_back(rd->cursor());
+  energy_cursors_.clear();
+  for (auto const& rd : energy_readers_)
+    energy_cursors_.push_back(rd->cursor());
+
+  // integrate all segments available on all inputs
+  duration_type done;
+  auto at_end = [](auto const& cur) { return cur.at_end(); };
+  while (std::none_of(power_cursors_.begin(), power_cursors_.end(), at_end) &&
+         std::none_of(energy_cursors_.begin(), energy_cursors_.end(), at_end)) {
+    auto seg = duration_type::infinity();
+    for (auto const& cur : power_cursors_)
+      seg = std::min(seg, cur.remaining());
+    for (auto const& cur : energy_cursors_)
+      seg = std::min(seg, cur.remaining());
+
+    SYSX_ASSERT(!seg.is_infinite() && "cannot integrate infinite tuples");
+
+    double watts = 0.0;
+    for (auto& cur : power_cursors_) {
+      watts += cur.tuple(seg).value();
+      cur.advance_segment(seg);
+    }
+    double joules = 0.0; // prorated by the process split policy
+    for (auto& cur : energy_cursors_) {
+      joules += cur.tuple(seg).value();
+      cur.advance_segment(seg);
+    }
+    integrate(watts, joules, seg);
+    done += seg;
+  }
+
+  // consume the integrated tuples
+  for (std::size_t i = 0; i < power_readers_.size(); ++i)
+    power_readers_[i]->pop_until(power_cursors_[i]);
+  for (std::size_t i = 0; i < energy_readers_.size(); ++i)
+    energy_readers_[i]->pop_until(energy_cursors_[i]);
+  power_cursors_.clear();
+  energy_cursors_.clear();
+
+  return done;
+}
+
+void
+timed_stream_energy_integrator::integrate(double watts,
+                                          double joules,
+                                          duration_type const& seg)
+{
+  // instantaneous energy belongs to the current window
+  if (seg == duration_type::zero_time) {
+    current_.add(joules);
+    total_.add(joules);
+    return;
+  }
+
+  if (window_ == duration_type::zero_time) {
+    current_.add(watts * to_seconds(seg) + joules);
+    total_.add(watts * to_seconds(seg) + joules);
+    close_window(seg);
+    return;
+  }
+
+  // distribute the energy of the segment over the windows
+  auto left = seg;
+  while (left > duration_type::zero_time) {
+    duration_type const window_left = window_ - window_pos_;
+    bool const closing = !(left < window_left);
+    auto const part = closing ? window_left : left;
+    double energy =
+      (watts + joules / to_seconds(seg)) * to_seconds(part);
+    current_.add(energy);
+    total_.add(energy);
+    window_pos_ += part;
+    left = closing ? left - part : duration_type();
+
+    // decided before the addition, which may round in native time
+    if (closing) {
+      close_window(window_);
+      window_pos_ = duration_type();
+    }
+  }
+}
+
+void
+timed_stream_energy_integrator::close_window(duration_type const& length)
+{
+  if (energy_)
+    energy_->push(current_.value(), length);
+  if (cumulative_)
+    cumulative_->push(total_.value(), length);
+
+  current_.reset();
+  emitted_until_ = emitted_until_ + length;
+}
+
+timed_stream_energy_integrator::duration_type
+timed_stream_energy_integrator::do_commit(duration_type until)
+{
+  // the outputs only cover the completed windows
+  for (auto&& out : outputs())
+    out->commit(emitted_until_);
+
+  return until;
+}
+
+} // namespace tracing
+
+/* Taf!
+ */
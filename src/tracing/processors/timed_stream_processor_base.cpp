@@ -31,9 +31,13 @@
 #include "tvs/utils/assert.h"
 #include "tvs/utils/unique_ptr.h"
 
+#include "../notify_worklist.h"
+
 namespace tracing {
 
-timed_stream_processor_base::timed_stream_processor_base() = default;
+timed_stream_processor_base::timed_stream_processor_base()
+  : resource_(sysx::utils::get_default_resource())
+{}
 
 void
 timed_stream_processor_base::update_cache()
@@ -97,6 +101,14 @@ timed_stream_processor_base::do_commit(duration_type until)
   return until;
 }
 
+void
+timed_stream_processor_base::collect_downstream(
+  std::vector<stream_base_type*>& streams) const
+{
+  for (auto&& out : outputs())
+    streams.push_back(&out->stream());
+}
+
 void
 timed_stream_processor_base::do_add_input(reader_ptr_type&& reader)
 {
@@ -108,6 +120,7 @@ void
 timed_stream_processor_base::do_add_output(writer_ptr_type&& writer)
 {
   outputs_.emplace_back(std::move(writer));
+  impl::graph_changed();
 }
 
 } // namespace tracing
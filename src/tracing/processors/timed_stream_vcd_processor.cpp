@@ -17,13 +17,11 @@ char const*
 vcd_stream_container_base::scope() const
 {
 
-#ifndef SYSX_NO_SYSTEMC
   if (scope_.empty()) {
     auto parent = this->reader().stream().get_parent_object();
     if (parent != nullptr)
       return parent->name();
   }
-#endif
 
   return scope_.c_str();
 }
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   timed_stream_window_aggregator.cpp
+ * \brief  time-weighted aggregation over windows (implementation)
+ * \see    timed_stream_window_aggregator.h
+ */
+
+#include "tvs/tracing/processors/timed_stream_window_aggregator.h"
+
+#include "tvs/utils/assert.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace tracing {
+
+timed_stream_window_aggregator_base::pane::pane(double relative_accuracy)
+  : weight()
+  , sum()
+  , sumsq()
+  , min()
+  , max()
+  , valid()
+  , sketch(relative_accuracy)
+{}
+
+void
+timed_stream_window_aggregator_base::pane::add(value_type v, double seconds)
+{
+  weight += seconds;
+  sum += v * seconds;
+  sumsq += v * v * seconds;
+  min = valid ? std::min(min, v) : v;
+  max = valid ? std::max(max, v) : v;
+  valid = true;
+}
+
+timed_stream_window_aggregator_base::timed_stream_window_aggregator_base(
+  duration_type const& window,
+  duration_type const& hop,
+  double relative_accuracy)
+  : window_(window)
+  , hop_(hop == duration_type::zero_time ? window : hop)
+  , panes_per_window_(1)
+  , accuracy_(relative_accuracy)
+  , pane_pos_()
+  , emitted_until_()
+  , pane_seq_()
+  , current_(relative_accuracy)
+  , sketch_(relative_accuracy)
+{
+  SYSX_ASSERT(window_ > duration_type::zero_time);
+  SYSX_ASSERT(!window_.is_infinite());
+  SYSX_ASSERT(hop_ <= window_ && "hop exceeds the window");
+
+  // compare with a tolerance, durations may be inexact (e.g. 0.3 s / 0.1 s)
+  auto const ratio = to_seconds(window_) / to_seconds(hop_);
+  panes_per_window_ = static_cast<std::size_t>(std::llround(ratio));
+  SYSX_ASSERT(std::abs(ratio - panes_per_window_) <= 1e-9 * ratio &&
+              "window is not a multiple of the hop");
+}
+
+void
+timed_stream_window_aggregator_base::mean_out(stream_type& stream)
+{
+  SYSX_ASSERT(!mean_ && "mean output already bound");
+  mean_ = base_type::out(stream);
+}
+
+void
+timed_stream_window_aggregator_base::min_out(stream_type& stream)
+{
+  SYSX_ASSERT(!minimum_ && "min output already bound");
+  minimum_ = base_type::out(stream);
+}
+
+void
+timed_stream_window_aggregator_base::max_out(stream_type& stream)
+{
+  SYSX_ASSERT(!maximum_ && "max output already bound");
+  maximum_ = base_type::out(stream);
+}
+
+void
+timed_stream_window_aggregator_base::rms_out(stream_type& stream)
+{
+  SYSX_ASSERT(!rms_ && "rms output already bound");
+  rms_ = base_type::out(stream);
+}
+
+void
+timed_stream_window_aggregator_base::percentile_out(double q,
+                                                    stream_type& stream)
+{
+  SYSX_ASSERT(q >= 0.0 && q <= 1.0);
+  percentiles_.emplace_back(q, base_type::out(stream));
+}
+
+void
+timed_stream_window_aggregator_base::aggregate(value_type v,
+                                               duration_type left)
+{
+  bool const sketched = !percentiles_.empty();
+
+  while (left > duration_type::zero_time) {
+    duration_type const pane_left = hop_ - pane_pos_;
+    bool const closing = !(left < pane_left);
+    auto const part = closing ? pane_left : left;
+    auto const seconds = to_seconds(part);
+    current_.add(v, seconds);
+    if (sketched)
+      current_.sketch.add(v, seconds);
+    pane_pos_ += part;
+    left -= part;
+
+    // decided before the addition, which may round in native time
+    if (closing) {
+      close_pane();
+      emit();
+      pane_pos_ = duration_type();
+    }
+  }
+}
+
+void
+timed_stream_window_aggregator_base::close_pane()
+{
+  auto const seq = pane_seq_++;
+
+  weight_.add(current_.weight);
+  sum_.add(current_.sum);
+  sumsq_.add(current_.sumsq);
+
+  if (current_.valid) {
+    while (!min_.empty() && min_.back().second >= current_.min)
+      min_.pop_back();
+    min_.emplace_back(seq, current_.min);
+    while (!max_.empty() && max_.back().second <= current_.max)
+      max_.pop_back();
+    max_.emplace_back(seq, current_.max);
+  }
+
+  if (!percentiles_.empty())
+    sketch_.merge(current_.sketch);
+
+  panes_.push_back(std::move(current_));
+  current_ = pane(accuracy_);
+
+  // evict the pane leaving the window
+  if (panes_.size() > panes_per_window_) {
+    auto const& old = panes_.front();
+    weight_.add(-old.weight);
+    sum_.add(-old.sum);
+    sumsq_.add(-old.sumsq);
+    if (!percentiles_.empty())
+      sketch_.subtract(old.sketch);
+    panes_.pop_front();
+
+    auto const first = pane_seq_ - panes_per_window_;
+    if (!min_.empty() && min_.front().first < first)
+      min_.pop_front();
+    if (!max_.empty() && max_.front().first < first)
+      max_.pop_front();
+  }
+}
+
+void
+timed_stream_window_aggregator_base::emit()
+{
+  auto const weight = weight_.value();
+  auto const mean = weight > 0.0 ? sum_.value() / weight : 0.0;
+  auto const meansq = weight > 0.0 ? std::max(sumsq_.value() / weight, 0.0)
+                                   : 0.0;
+
+  if (mean_)
+    mean_->push(mean, hop_);
+  if (rms_)
+    rms_->push(std::sqrt(meansq), hop_);
+  if (minimum_)
+    minimum_->push(min_.empty() ? 0.0 : min_.front().second, hop_);
+  if (maximum_)
+    maximum_->push(max_.empty() ? 0.0 : max_.front().second, hop_);
+
+  for (auto const& p : percentiles_)
+    p.second->push(sketch_.quantile(p.first), hop_);
+
+  emitted_until_ = emitted_until_ + hop_;
+}
+
+timed_stream_window_aggregator_base::duration_type
+timed_stream_window_aggregator_base::do_commit(duration_type until)
+{
+  // the outputs only cover the completed hops
+  for (auto&& out : outputs())
+    out->commit(emitted_until_);
+
+  return until;
+}
+
+} // namespace tracing
+
+/* Taf!
+ */
@@ -23,28 +23,439 @@
  */
 
 #include "tvs/tracing/timed_object.h"
+#include "tvs/tracing/timed_reader_base.h"
 #include "tvs/tracing/timed_stream_base.h"
 
+#include "notify_worklist.h"
+#include "object_registry.h"
+
 #include "tvs/tracing/report_msgs.h"
 
 #include "tvs/utils/debug.h"
 #include "tvs/utils/macros.h"
-
-#ifdef SYSX_NO_SYSTEMC
-#include <map>
-#endif
+#include "tvs/utils/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace {
 
 tracing::host::sync_fn_type sync_fn;
+bool sync_fn_default = false; ///< sync_fn is the SystemC default
+tracing::host::sync_fn_type block_fn;
+
+using stream_list = std::vector<tracing::timed_stream_base*>;
+using stream_registry_type =
+  std::unordered_map<tracing::named_object const*, stream_list>;
+
+/// cached streams per parent scope (nullptr for top-level streams)
+stream_registry_type&
+stream_registry()
+{
+  static stream_registry_type registry;
+  return registry;
+}
+
+/// worker threads for concurrent synchronisation (if enabled)
+std::unique_ptr<sysx::utils::thread_pool> sync_pool;
+
+/// set while the calling thread executes a task of the sync_pool
+thread_local bool sync_task_active = false;
+
+/// run the tasks on the sync_pool, nested batches are run serially
+void
+run_sync_tasks(std::vector<sysx::utils::thread_pool::task_type>& tasks)
+{
+  // avoid the hand-over for a single task
+  if (!sync_pool || sync_task_active || tasks.size() == 1) {
+    for (auto& task : tasks)
+      task();
+    return;
+  }
+
+  std::vector<sysx::utils::thread_pool::task_type> wrapped;
+  wrapped.reserve(tasks.size());
+  for (auto& task : tasks) {
+    wrapped.emplace_back([&task] {
+      struct active_guard
+      {
+        bool prev = sync_task_active;
+        active_guard() { sync_task_active = true; }
+        ~active_guard() { sync_task_active = prev; }
+      } guard;
+      task();
+    });
+  }
+  sync_pool->run(wrapped);
+}
+
+/// Partition the given streams into independent sets.
+///
+/// Streams are connected via their readers to the readers' listeners, which
+/// are in turn connected to the streams they write to.  The connected
+/// components of this graph are determined with a union-find structure.  The
+/// streams of each set keep their relative order.
+std::vector<stream_list>
+partition_streams(stream_list const& streams)
+{
+  std::unordered_map<void const*, std::size_t> index;
+  std::vector<std::size_t> parent;
+
+  auto node = [&](void const* ptr) {
+    auto res = index.emplace(ptr, parent.size());
+    if (res.second)
+      parent.push_back(parent.size());
+    return res.first->second;
+  };
+
+  auto find = [&](std::size_t n) {
+    while (parent[n] != n) {
+      parent[n] = parent[parent[n]];
+      n = parent[n];
+    }
+    return n;
+  };
+
+  auto unite = [&](std::size_t a, std::size_t b) {
+    a = find(a);
+    b = find(b);
+    if (a != b)
+      parent[std::max(a, b)] = std::min(a, b);
+  };
+
+  std::unordered_set<tracing::timed_stream_base const*> visited;
+  stream_list pending(streams.rbegin(), streams.rend());
+  stream_list downstream;
+
+  while (!pending.empty()) {
+    auto* stream = pending.back();
+    pending.pop_back();
+    if (!visited.insert(stream).second)
+      continue;
+
+    auto stream_node = node(stream);
+    for (auto* reader : stream->readers()) {
+      auto* listener = reader->listener();
+      if (listener == nullptr)
+        continue;
+
+      auto listener_node = node(listener);
+      unite(stream_node, listener_node);
+
+      downstream.clear();
+      listener->collect_downstream(downstream);
+      for (auto* next : downstream) {
+        unite(listener_node, node(next));
+        pending.push_back(next);
+      }
+    }
+  }
+
+  std::vector<stream_list> parts;
+  std::unordered_map<std::size_t, std::size_t> part_of;
+  for (auto* stream : streams) {
+    auto res = part_of.emplace(find(node(stream)), parts.size());
+    if (res.second)
+      parts.emplace_back();
+    parts[res.first->second].push_back(stream);
+  }
+  return parts;
+}
+
+/* ----------------------- notification worklist ----------------------- */
+
+tracing::notify_mode notify_mode_ = tracing::notify_mode::immediate;
+
+/// depth of the streams in the stream graph (longest path from a source)
+struct stream_ranks_type
+{
+  std::atomic<unsigned> graph_epoch{ 1 };
+  std::atomic<unsigned> epoch{ 0 };
+  std::mutex mutex;
+  std::unordered_map<tracing::timed_stream_base const*, unsigned> ranks;
+  /// deepest rank of the input streams of each listener
+  std::unordered_map<tracing::timed_listener_if const*, unsigned> listeners;
+  bool acyclic = true;
+};
+
+stream_ranks_type&
+stream_ranks()
+{
+  static stream_ranks_type instance;
+  return instance;
+}
+
+/// recompute the stream ranks after the stream graph has changed
+void
+update_stream_ranks()
+{
+  auto& sr = stream_ranks();
+  if (sr.epoch.load(std::memory_order_acquire) == sr.graph_epoch.load())
+    return;
+
+  std::lock_guard<std::mutex> lock(sr.mutex);
+  unsigned epoch = sr.graph_epoch.load();
+  if (sr.epoch.load() == epoch)
+    return;
+
+  using stream_ptr = tracing::timed_stream_base*;
+  std::unordered_map<stream_ptr, stream_list> edges;
+  std::unordered_map<stream_ptr, unsigned> indegree;
+  std::vector<std::pair<stream_ptr, tracing::timed_listener_if*>> inputs;
+  stream_list downstream;
+
+  for (auto const& scope : stream_registry()) {
+    for (auto* stream : scope.second) {
+      indegree.emplace(stream, 0);
+      for (auto* reader : stream->readers()) {
+        if (reader->listener() == nullptr)
+          continue;
+        inputs.emplace_back(stream, reader->listener());
+        downstream.clear();
+        reader->listener()->collect_downstream(downstream);
+        for (auto* next : downstream) {
+          edges[stream].push_back(next);
+          ++indegree[next];
+        }
+      }
+    }
+  }
+
+  // Kahn's algorithm, streams on cycles keep their preliminary rank
+  sr.ranks.clear();
+  stream_list ready;
+  for (auto const& node : indegree) {
+    sr.ranks[node.first] = 0;
+    if (node.second == 0)
+      ready.push_back(node.first);
+  }
+  std::size_t ranked = 0;
+  while (!ready.empty()) {
+    auto* stream = ready.back();
+    ready.pop_back();
+    ++ranked;
+    for (auto* next : edges[stream]) {
+      auto& rank = sr.ranks[next];
+      rank = std::max(rank, sr.ranks[stream] + 1);
+      if (--indegree[next] == 0)
+        ready.push_back(next);
+    }
+  }
+  sr.acyclic = (ranked == indegree.size());
+
+  // a listener is notified once all of its inputs have been committed
+  sr.listeners.clear();
+  for (auto const& input : inputs) {
+    auto& rank = sr.listeners[input.second];
+    rank = std::max(rank, sr.ranks[input.first]);
+  }
+
+  sr.epoch.store(epoch, std::memory_order_release);
+}
+
+struct notify_entry
+{
+  unsigned rank;
+  std::size_t seq;
+  tracing::timed_reader_base* reader;
+
+  // priority_queue yields the largest element first
+  bool operator<(notify_entry const& that) const
+  {
+    return rank != that.rank ? rank > that.rank : seq > that.seq;
+  }
+};
+
+/// queued notifications of the calling thread
+struct notify_worklist_type
+{
+  unsigned depth = 0;
+  bool draining = false;
+  std::size_t seq = 0;
+  std::priority_queue<notify_entry> queue;
+  std::unordered_set<tracing::timed_reader_base*> queued;
+  /// collects the notifications of a concurrently notified listener
+  std::vector<tracing::timed_reader_base*>* sink = nullptr;
+};
+
+thread_local notify_worklist_type notify_worklist;
+
+void
+enqueue_notify(notify_worklist_type& wl, tracing::timed_reader_base& reader)
+{
+  if (!wl.queued.insert(&reader).second)
+    return; // already queued
+
+  // order by the deepest input of the listener, so that a listener reading
+  // streams of different ranks only runs after all of them have settled
+  update_stream_ranks();
+  auto const& sr = stream_ranks();
+  unsigned rank = 0;
+  auto it = sr.listeners.find(reader.listener());
+  if (it != sr.listeners.end()) {
+    rank = it->second;
+  } else {
+    auto st = sr.ranks.find(&reader.stream());
+    if (st != sr.ranks.end())
+      rank = st->second;
+  }
+
+  wl.queue.push(notify_entry{ rank, wl.seq++, &reader });
+}
+
+void
+dispatch_notify(tracing::timed_reader_base& reader)
+{
+  // skip readers consumed in the meantime
+  if (!reader.available())
+    return;
+  if (auto* listener = reader.listener())
+    listener->notify(reader);
+}
+
+/// Notify the listeners of all queued readers of the lowest rank.
+///
+/// A listener is ranked by the deepest of its input streams and only writes
+/// to streams of a higher rank, so all inputs of the listeners of a rank have
+/// been committed before and the listeners are independent of each other.
+/// They are notified concurrently, each listener on a single thread.  The
+/// notifications raised by a listener are collected separately and queued in
+/// the order of the listeners afterwards, which keeps the processing order
+/// independent of the scheduling.
+void
+notify_wave(notify_worklist_type& wl)
+{
+  unsigned rank = wl.queue.top().rank;
+
+  std::vector<std::vector<tracing::timed_reader_base*>> groups;
+  std::unordered_map<tracing::timed_listener_if*, std::size_t> group_of;
+  while (!wl.queue.empty() && wl.queue.top().rank == rank) {
+    auto* reader = wl.queue.top().reader;
+    wl.queue.pop();
+    if (wl.queued.erase(reader) == 0 || reader->listener() == nullptr)
+      continue; // cancelled
+
+    auto res = group_of.emplace(reader->listener(), groups.size());
+    if (res.second)
+      groups.emplace_back();
+    groups[res.first->second].push_back(reader);
+  }
+
+  std::vector<std::vector<tracing::timed_reader_base*>> raised(groups.size());
+  std::vector<sysx::utils::thread_pool::task_type> tasks;
+  for (std::size_t i = 0; i < groups.size(); ++i) {
+    tasks.emplace_back([&groups, &raised, i] {
+      auto& local = notify_worklist;
+      auto* prev = local.sink;
+      local.sink = &raised[i];
+      for (auto* reader : groups[i])
+        dispatch_notify(*reader);
+      local.sink = prev;
+    });
+  }
+  run_sync_tasks(tasks);
+
+  for (auto const& readers : raised)
+    for (auto* reader : readers)
+      enqueue_notify(wl, *reader);
+}
+
+/// interned object names, the returned pointers are never invalidated
+tracing::impl::name_arena&
+names()
+{
+  static tracing::impl::name_arena arena;
+  return arena;
+}
+
+/// streams by their hierarchical (interned) name
+tracing::impl::name_map<tracing::timed_stream_base>&
+stream_names()
+{
+  static tracing::impl::name_map<tracing::timed_stream_base> registry;
+  return registry;
+}
+
+tracing::timed_stream_base*
+find_stream(const char* name)
+{
+  return stream_names().find(names().find(name));
+}
 
 #ifdef SYSX_NO_SYSTEMC
 
 /// object registry for timed_object instances
-std::map<std::string, tracing::named_object*> object_registry;
+tracing::impl::name_map<tracing::named_object>&
+object_registry()
+{
+  static tracing::impl::name_map<tracing::named_object> registry;
+  return registry;
+}
+
+/// current scope of the calling thread
+thread_local tracing::named_object* current_scope_ = nullptr;
+
+/// separator for hierarchical names (cf. sc_core::SC_HIERARCHY_CHAR)
+const char hierarchy_char = '.';
+
+#else
+
+const char hierarchy_char = sc_core::SC_HIERARCHY_CHAR;
 
 #endif // SYSX_NO_SYSTEMC
 
+/// name of the current scope, nullptr at the top-level
+const char*
+current_scope_name()
+{
+#ifdef SYSX_NO_SYSTEMC
+  return current_scope_ ? current_scope_->name() : nullptr;
+#else
+  auto scope = sc_core::sc_get_current_object();
+  return scope ? scope->name() : nullptr;
+#endif
+}
+
+/// hierarchical name relative to the given scope (in a thread-local buffer)
+const char*
+scoped_name(const char* scope, const char* name)
+{
+  thread_local std::string buf;
+  buf.assign(scope);
+  buf += hierarchy_char;
+  buf += name;
+  return buf.c_str();
+}
+
+/// does an object with the given hierarchical name exist?
+bool
+object_exists(const char* name)
+{
+#ifdef SYSX_NO_SYSTEMC
+  return object_registry().find(names().find(name)) != nullptr;
+#else
+  return sc_core::sc_find_object(name) != nullptr;
+#endif
+}
+
+/// does an object with the given name exist in the current scope?
+bool
+name_exists(const char* name)
+{
+  auto scope = current_scope_name();
+  return object_exists(scope ? scoped_name(scope, name) : name);
+}
+
 } // anonymous namespace
 
 namespace tracing {
@@ -52,15 +463,147 @@ namespace tracing {
 void
 register_sync(host::sync_fn_type fn)
 {
-  if (sync_fn) {
+  if (sync_fn && fn) {
     SYSX_REPORT_WARNING(sysx::report::plain_msg)
       << "Overriding already defined synchronisation function.";
   }
   sync_fn = fn;
+  sync_fn_default = false;
+}
+
+host::sync_fn_type
+register_block_sync(host::sync_fn_type fn)
+{
+  std::swap(block_fn, fn);
+  return fn;
+}
+
+void
+set_sync_concurrency(unsigned num_threads)
+{
+  if (num_threads == 0)
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+  // the calling thread participates in the synchronisation
+  sync_pool.reset();
+  if (num_threads > 1)
+    sync_pool.reset(new sysx::utils::thread_pool(num_threads - 1));
+}
+
+void
+set_notify_mode(notify_mode mode)
+{
+  notify_mode_ = mode;
 }
 
+notify_mode
+get_notify_mode()
+{
+  return notify_mode_;
+}
+
+namespace impl {
+
+notify_batch::notify_batch()
+{
+  ++notify_worklist.depth;
+}
+
+notify_batch::~notify_batch()
+{
+  auto& wl = notify_worklist;
+  --wl.depth;
+  if (dispatching_)
+    wl.draining = false;
+
+  // drop the notifications of an aborted commit
+  if (!wl.depth && !wl.draining && !wl.queue.empty()) {
+    wl.queue = decltype(wl.queue)();
+    wl.queued.clear();
+  }
+}
+
+void
+notify_batch::dispatch()
+{
+  dispatch_below(std::numeric_limits<unsigned>::max());
+}
+
+void
+notify_batch::dispatch_below(unsigned rank)
+{
+  auto& wl = notify_worklist;
+  if (wl.depth > 1 || wl.draining)
+    return;
+
+  // listeners committing their outputs only extend the worklist
+  wl.draining = dispatching_ = true;
+  while (!wl.queue.empty() && wl.queue.top().rank < rank) {
+    if (notify_mode_ == notify_mode::parallel && sync_pool &&
+        !sync_task_active && stream_ranks().acyclic) {
+      notify_wave(wl);
+      continue;
+    }
+
+    auto* reader = wl.queue.top().reader;
+    wl.queue.pop();
+    if (wl.queued.erase(reader) != 0) // not cancelled
+      dispatch_notify(*reader);
+  }
+  wl.draining = dispatching_ = false;
+}
+
+bool
+defer_notify(timed_reader_base& reader)
+{
+  auto& wl = notify_worklist;
+  if (notify_mode_ == notify_mode::immediate)
+    return false;
+
+  if (wl.sink) { // within a concurrent notification
+    wl.sink->push_back(&reader);
+    return true;
+  }
+  if (!wl.depth && !wl.draining)
+    return false;
+
+  enqueue_notify(wl, reader);
+  return true;
+}
+
+void
+cancel_notify(timed_reader_base& reader)
+{
+  notify_worklist.queued.erase(&reader);
+}
+
+void
+graph_changed()
+{
+  ++stream_ranks().graph_epoch;
+}
+
+} // namespace impl
+
 namespace host {
 
+/// maximum number of additional synchronisations for blocking readers
+static const int max_block_retries = 8;
+
+/// number of tuples by which blocking readers in the scope exceed their limit
+static std::size_t
+blocked_tuples()
+{
+  std::size_t excess = 0;
+  for_each_stream_in_scope([&excess](timed_stream_base* stream) {
+    for (auto* reader : stream->readers())
+      if (reader->blocking())
+        excess += reader->count() - reader->buffer_limit();
+    return false;
+  });
+  return excess;
+}
+
 void
 sync_with_model(time_type until)
 {
@@ -69,6 +612,7 @@ sync_with_model(time_type until)
     SYSX_REPORT_WARNING(sysx::report::plain_msg)
       << "Setting sc_core::wait as the default synchronisation function.";
     sync_fn = [](time_type const& until) { ::sc_core::wait(until - sc_core::sc_time_stamp()); };
+    sync_fn_default = true;
 #else
     SYSX_REPORT_FATAL(sysx::report::plain_msg)
       << "Cannot synchronise: no sync method specified."
@@ -77,106 +621,154 @@ sync_with_model(time_type until)
 #endif
   }
   sync_fn(until);
+
+  // skip the scans of the scope without any blocking readers
+  if (timed_reader_base::num_blocking_ == 0)
+    return;
+
+  // back-pressure: give blocking readers a bounded number of chances to catch
+  // up, as long as they make progress
+  auto block = block_fn;
+#ifndef SYSX_NO_SYSTEMC
+  // the default model synchronisation runs in a SystemC thread
+  if (!block && sync_fn_default)
+    block = [](time_type const&) { ::sc_core::wait(::sc_core::SC_ZERO_TIME); };
+#endif
+  auto excess = block ? blocked_tuples() : 0;
+  for (int retry = 0; excess > 0 && retry < max_block_retries; ++retry) {
+    block(until);
+    auto remaining = blocked_tuples();
+    if (remaining >= excess)
+      break;
+    excess = remaining;
+  }
+
+  // warn once per reader, until it has caught up again
+  for_each_stream_in_scope([](timed_stream_base* stream) {
+    for (auto* reader : stream->readers()) {
+      if (!reader->blocking()) {
+        reader->block_reported_ = false;
+      } else if (!reader->block_reported_) {
+        reader->block_reported_ = true;
+        SYSX_REPORT_WARNING(sysx::report::plain_msg)
+          << "Blocking reader '" << reader->name()
+          << "' does not consume its buffered tuples ("
+          << reader->count() - reader->buffer_limit()
+          << " above limit), continuing.";
+      }
+    }
+    return false;
+  });
 }
 
-/// Apply func on all streams in the current SystemC module scope.
+/// Apply func on all streams in the current scope, i.e. the SystemC module of
+/// the current process or the native scope of the calling thread.
 ///
 /// The iteration stops when func returns true.
 void
 for_each_stream_in_scope(host::cb_type func)
 {
 #ifdef SYSX_NO_SYSTEMC
-  SYSX_REPORT_FATAL(sysx::report::not_implemented) % "native scope traversal";
+  named_object const* scope = current_scope_;
 #else
   sc_core::sc_object* scope = sc_core::sc_get_current_object();
   SYSX_ASSERT(scope != nullptr);
 
   scope = scope->get_parent_object();
   SYSX_ASSERT(scope != nullptr);
+#endif
 
-  for (auto& obj : scope->get_child_objects()) {
-    auto* stream = dynamic_cast<timed_stream_base*>(&(*obj));
-    if (stream != nullptr) {
-      if (func(stream))
-        break;
-    }
+  // use the cached stream list instead of scanning all child objects
+  auto it = stream_registry().find(scope);
+  if (it == stream_registry().end())
+    return;
+
+  auto& streams = it->second;
+  for (stream_list::size_type i = 0; i < streams.size(); ++i) {
+    if (func(streams[i]))
+      break;
   }
-#endif
+}
+
+void
+register_stream(timed_stream_base* stream)
+{
+  SYSX_ASSERT(stream != nullptr);
+  stream_registry()[stream->get_parent_object()].push_back(stream);
+  stream_names().insert(names().intern(stream->name()), stream);
+  impl::graph_changed();
+}
+
+void
+unregister_stream(timed_stream_base* stream)
+{
+  stream_names().erase(names().find(stream->name()));
+  impl::graph_changed();
+
+  auto it = stream_registry().find(stream->get_parent_object());
+  if (it == stream_registry().end())
+    return;
+
+  auto& streams = it->second;
+  streams.erase(std::remove(streams.begin(), streams.end(), stream),
+                streams.end());
+  if (streams.empty())
+    stream_registry().erase(it);
 }
 
 const char*
 gen_unique_name(const char* name)
 {
 #ifdef SYSX_NO_SYSTEMC
-  static std::vector<std::string> names_;
   static int num = 0;
 
-  auto it = object_registry.find(name);
-
-  if (it != object_registry.end()) {
-    std::stringstream sstr;
-    sstr << name << "_" << num++;
-    names_.emplace_back(sstr.str());
-    return names_.back().c_str();
-  }
+  if (!name_exists(name))
+    return names().intern(name);
 
-  return name;
+  std::string nm;
+  do {
+    nm = name;
+    nm += '_';
+    nm += std::to_string(num++);
+  } while (name_exists(nm.c_str()));
 
+  return names().intern(nm.c_str(), nm.size());
 #else
-  return sc_core::sc_gen_unique_name(name);
+  // sc_gen_unique_name returns a temporary buffer
+  return names().intern(sc_core::sc_gen_unique_name(name));
 #endif // SYSX_NO_SYSTEMC
 }
 
 tracing::timed_stream_base*
 lookup(const char* name)
 {
-#ifdef SYSX_NO_SYSTEMC
-  auto it = object_registry.find(name);
+  auto str = find_stream(name);
 
-  timed_stream_base* str = nullptr;
+  // retry relative to the current scope
+  auto scope = current_scope_name();
+  if (str == nullptr && scope != nullptr)
+    str = find_stream(scoped_name(scope, name));
 
-  if (it == object_registry.end()) {
-    SYSX_REPORT_WARNING(report::stream_lookup) % name
-      << "object not found in hierarchy";
-  } else {
-    str = dynamic_cast<timed_stream_base*>(it->second);
-    if (str == nullptr) {
+  if (str == nullptr) {
+    if (object_exists(name) ||
+        (scope != nullptr && object_exists(scoped_name(scope, name)))) {
       SYSX_REPORT_WARNING(report::stream_lookup) % name
         << "could not cast to timed_stream_base";
-    }
-  }
-
-  return str;
-
-#else
-  auto str = dynamic_cast<timed_stream_base*>(sc_core::sc_find_object(name));
-
-  if (!str) {
-    auto scope = sc_core::sc_get_current_object();
-    if (scope) {
-      std::stringstream lname;
-      lname << scope->name() << sc_core::SC_HIERARCHY_CHAR << name;
-      str = dynamic_cast<timed_stream_base*>(sc_core::sc_find_object(lname.str().c_str()));
-    }
-
-    if (!str) {
+    } else {
       SYSX_REPORT_WARNING(report::stream_lookup) % name
         << "object not found "
-        << "(scope: " << (scope ? scope->name() : "<top>") << ")";
-      return nullptr;
+        << "(scope: " << (scope ? scope : "<top>") << ")";
     }
   }
 
   return str;
-#endif // SYSX_NO_SYSTEMC
 }
 
 char const*
 current_object_name()
 {
 #ifdef SYSX_NO_SYSTEMC
-  SYSX_REPORT_FATAL(sysx::report::not_implemented) % "object name retrieval";
-  return "";
+  return current_scope_ ? current_scope_->name() : "";
 #else
   auto obj = sc_core::sc_get_current_object();
   SYSX_ASSERT(obj != nullptr);
@@ -185,6 +777,27 @@ current_object_name()
 #endif
 }
 
+#ifdef SYSX_NO_SYSTEMC
+
+named_object*
+current_scope()
+{
+  return current_scope_;
+}
+
+scope_guard::scope_guard(named_object& scope)
+  : prev_(current_scope_)
+{
+  current_scope_ = &scope;
+}
+
+scope_guard::~scope_guard()
+{
+  current_scope_ = prev_;
+}
+
+#endif // SYSX_NO_SYSTEMC
+
 } // namespace host
 
 /* ----------------------------- sync --------------------------- */
@@ -203,13 +816,82 @@ sync()
   return max_time;
 }
 
+namespace {
+
+/// Commit the \a streams in the order of their ranks.
+///
+/// The deferred notifications are dispatched before committing the streams of
+/// the next rank, i.e. a listener runs once after all of its inputs have been
+/// committed and before its outputs are committed by the sync.  In a cyclic
+/// stream graph, the notifications are dispatched after each stream.
 void
-sync(time_type const& until)
+commit_ranked(stream_list& streams, time_type const& until)
 {
-  host::for_each_stream_in_scope([&until](timed_stream_base* stream) {
+  auto const& sr = stream_ranks();
+  auto rank = [&sr](timed_stream_base* stream) {
+    if (!sr.acyclic)
+      return std::numeric_limits<unsigned>::max();
+    auto it = sr.ranks.find(stream);
+    return it != sr.ranks.end() ? it->second : 0u;
+  };
+  std::stable_sort(streams.begin(),
+                   streams.end(),
+                   [&rank](timed_stream_base* a, timed_stream_base* b) {
+                     return rank(a) < rank(b);
+                   });
+
+  impl::notify_batch batch;
+  for (auto* stream : streams) {
+    batch.dispatch_below(rank(stream));
     stream->commit(until);
+  }
+  batch.dispatch();
+}
+
+} // anonymous namespace
+
+void
+sync(time_type const& until)
+{
+  bool const ranked = (notify_mode_ != notify_mode::immediate);
+
+  if (!sync_pool && !ranked) {
+    host::for_each_stream_in_scope([&until](timed_stream_base* stream) {
+      stream->commit(until);
+      return false;
+    });
+    return;
+  }
+
+  stream_list streams;
+  host::for_each_stream_in_scope([&streams](timed_stream_base* stream) {
+    streams.push_back(stream);
     return false;
   });
+
+  if (ranked)
+    update_stream_ranks();
+
+  if (!sync_pool) {
+    commit_ranked(streams, until);
+    return;
+  }
+
+  auto parts = partition_streams(streams);
+
+  std::vector<sysx::utils::thread_pool::task_type> tasks;
+  for (auto& part : parts) {
+    if (ranked) {
+      // the listeners are local to the partition
+      tasks.emplace_back([&part, &until] { commit_ranked(part, until); });
+    } else {
+      tasks.emplace_back([&part, &until] {
+        for (auto* stream : part)
+          stream->commit(until);
+      });
+    }
+  }
+  run_sync_tasks(tasks);
 }
 
 /* ----------------------------- timed_base --------------------------- */
@@ -252,24 +934,55 @@ timed_base::do_commit(duration_type duration)
 #ifdef SYSX_NO_SYSTEMC
 
 named_object::named_object(const char* name)
-  : name_(name)
+  : parent_(current_scope_)
+  , children_()
+  , name_(names().intern(parent_ ? scoped_name(parent_->name(), name) : name))
+  , base_(std::strlen(name_) - std::strlen(name))
 {
-  if (object_registry.find(name) != object_registry.end()) {
+  if (!object_registry().insert(name_, this)) {
     SYSX_REPORT_FATAL(sysx::report::plain_msg)
-      << "timed_object " << name << " already defined.";
+      << "timed_object " << name_ << " already defined.";
   }
-  object_registry[name] = this;
+
+  if (parent_ != nullptr)
+    parent_->children_.push_back(this);
 }
 
 named_object::~named_object()
 {
-  object_registry.erase(name());
+  if (!children_.empty()) {
+    SYSX_REPORT_WARNING(sysx::report::plain_msg)
+      << "object " << name() << " destroyed before its " << children_.size()
+      << " child object(s), moving them to the top-level";
+
+    // remaining streams are synchronised with the top-level from now on
+    auto it = stream_registry().find(this);
+    if (it != stream_registry().end()) {
+      stream_list streams;
+      streams.swap(it->second);
+      stream_registry().erase(it);
+
+      auto& top = stream_registry()[nullptr];
+      top.insert(top.end(), streams.begin(), streams.end());
+    }
+
+    for (auto* child : children_)
+      child->parent_ = nullptr;
+  }
+
+  if (parent_ != nullptr) {
+    auto& siblings = parent_->children_;
+    siblings.erase(std::remove(siblings.begin(), siblings.end(), this),
+                   siblings.end());
+  }
+
+  object_registry().erase(name_);
 }
 
 const char*
 named_object::name() const
 {
-  return name_.c_str();
+  return name_;
 }
 
 const char*
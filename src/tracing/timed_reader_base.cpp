@@ -30,17 +30,29 @@
 
 #include "tvs/tracing/report_msgs.h"
 
+#include "notify_worklist.h"
+
 namespace tracing {
 
+timed_reader_base::size_type timed_reader_base::num_blocking_ = 0;
+
 timed_reader_base::timed_reader_base(const char* name)
   : timed_object(name)
   , stream_()
   , listener_()
   , listen_mode_(timed_listener_if::NOTIFY_NONE)
+  , buffer_limit_()
+  , buffer_policy_(buffer_policy::unbounded)
+  , high_water_()
+  , dropped_()
+  , coalesced_()
+  , block_reported_()
+  , block_counted_()
 {}
 
 timed_reader_base::~timed_reader_base()
 {
+  impl::cancel_notify(*this);
   detach();
 }
 
@@ -65,6 +77,7 @@ timed_reader_base::attach(timed_stream_base& stream)
 
   stream_ = &stream;
   stream_->attach(*this);
+  update_block_count();
 }
 
 void
@@ -74,6 +87,7 @@ timed_reader_base::detach()
     return;
   stream_->detach(*this);
   stream_ = nullptr;
+  update_block_count();
 }
 
 timed_reader_base::listener_mode
@@ -81,6 +95,7 @@ timed_reader_base::listen(timed_listener_if& listener, listener_mode mode)
 {
   listener_mode ret = listen_mode_;
   listen_mode_ = mode;
+  impl::graph_changed();
 
   // discard registered listener
   if (mode == timed_listener_if::NOTIFY_NONE) {
@@ -101,6 +116,99 @@ timed_reader_base::listen(timed_listener_if& listener, listener_mode mode)
   return ret; // avoid compile error
 }
 
+void
+timed_reader_base::trigger(bool new_window)
+{
+  if (!(listen_mode_ & (new_window ? timed_listener_if::NOTIFY_WINDOW
+                                   : timed_listener_if::NOTIFY_APPEND)))
+    return;
+
+  if (!impl::defer_notify(*this))
+    listener_->notify(*this);
+}
+
+void
+timed_reader_base::set_buffer_limit(size_type max_tuples, buffer_policy policy)
+{
+  if (max_tuples == 0 || policy == buffer_policy::unbounded) {
+    buffer_limit_ = 0;
+    buffer_policy_ = buffer_policy::unbounded;
+    update_block_count();
+    return;
+  }
+
+  // need room for the gap tuple and the most recent tuple
+  SYSX_ASSERT(max_tuples >= 2 && "buffer limit too small");
+
+  if (policy == buffer_policy::spill && !can_spill()) {
+    SYSX_REPORT_WARNING(sysx::report::plain_msg)
+      << "Reader '" << name() << "' cannot spill its values "
+      << "(not trivially copyable), dropping the oldest tuples instead.";
+    policy = buffer_policy::drop_oldest;
+  }
+
+  buffer_limit_ = max_tuples;
+  buffer_policy_ = policy;
+  update_block_count();
+  enforce_buffer_limit();
+}
+
+timed_reader_statistics
+timed_reader_base::statistics() const
+{
+  timed_reader_statistics stats;
+  stats.lag = available_duration();
+  stats.count = count();
+  stats.high_water = high_water_;
+  stats.dropped = dropped_;
+  stats.coalesced = coalesced_;
+  stats.spilled = spilled();
+  return stats;
+}
+
+void
+timed_reader_base::enforce_buffer_limit()
+{
+  if (count() > high_water_)
+    high_water_ = count();
+
+  if (buffer_policy_ == buffer_policy::unbounded || count() <= buffer_limit_)
+    return;
+
+  switch (buffer_policy_) {
+    case buffer_policy::coalesce:
+      coalesced_ += do_coalesce();
+      if (count() <= buffer_limit_)
+        break;
+    // fall through
+    case buffer_policy::drop_oldest:
+      dropped_ += do_drop_oldest(buffer_limit_);
+      break;
+    case buffer_policy::spill:
+      do_spill(buffer_limit_);
+      break;
+    case buffer_policy::block:     // handled by host::sync_with_model()
+    case buffer_policy::unbounded: // not reached
+      break;
+  }
+}
+
+void
+timed_reader_base::update_block_count()
+{
+  bool const counted = stream_ && buffer_policy_ == buffer_policy::block;
+  if (counted == block_counted_)
+    return;
+
+  block_counted_ = counted;
+  if (counted) {
+    ++num_blocking_;
+  } else {
+    --num_blocking_;
+    block_reported_ = false;
+  }
+}
+
 } // namespace tracing
 
 /* Taf!
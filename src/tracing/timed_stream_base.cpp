@@ -30,6 +30,8 @@
 
 #include "tvs/tracing/report_msgs.h"
 
+#include "notify_worklist.h"
+
 namespace tracing {
 
 /* ------------------------- timed_stream_base ------------------------- */
@@ -38,10 +40,16 @@ timed_stream_base::timed_stream_base(const char* nm)
   : timed_object(nm)
   , writer_()
   , readers_()
-{}
+  , buffer_limit_()
+  , buffer_policy_(buffer_policy::unbounded)
+{
+  host::register_stream(this);
+}
 
 timed_stream_base::~timed_stream_base()
 {
+  host::unregister_stream(this);
+
   while (readers_.begin() != readers_.end())
     readers_.front()->detach();
 
@@ -88,6 +96,11 @@ timed_stream_base::attach(timed_reader_base& reader)
     return;
   }
   readers_.push_back(&reader);
+  impl::graph_changed();
+
+  if (buffer_policy_ != buffer_policy::unbounded &&
+      reader.limit_policy() == buffer_policy::unbounded)
+    reader.set_buffer_limit(buffer_limit_, buffer_policy_);
 }
 
 void
@@ -95,6 +108,18 @@ timed_stream_base::detach(timed_reader_base& reader)
 {
   auto it = std::remove(readers_.begin(), readers_.end(), &reader);
   readers_.erase(it, readers_.end());
+  impl::graph_changed();
+}
+
+void
+timed_stream_base::set_buffer_limit(std::size_t max_tuples,
+                                    buffer_policy policy)
+{
+  buffer_limit_ = max_tuples;
+  buffer_policy_ = max_tuples ? policy : buffer_policy::unbounded;
+
+  for (auto* reader : readers_)
+    reader->set_buffer_limit(buffer_limit_, buffer_policy_);
 }
 
 timed_stream_base::duration_type
@@ -103,6 +128,9 @@ timed_stream_base::do_commit(duration_type until)
   if (until == timed_duration::zero_time)
     until = duration();
 
+  // deferred notifications are dispatched at the end of the outermost commit
+  impl::notify_batch batch;
+
   auto begin = readers_.begin(), end = readers_.end();
 
   do_pre_commit_reader(until);
@@ -114,10 +142,14 @@ timed_stream_base::do_commit(duration_type until)
   }
 
   while (end - begin > 1) {
-    do_commit_reader(**(begin++), until);
+    do_commit_reader(**begin, until);
+    (*begin++)->enforce_buffer_limit();
   }
 
   do_commit_reader(**begin, until, /* last = */ true);
+  (*begin)->enforce_buffer_limit();
+
+  batch.dispatch();
   return until;
 }
 
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   memory_resource.cpp
+ * \brief  polymorphic memory resources (implementation)
+ * \see    memory_resource.h
+ */
+
+#include "tvs/utils/memory_resource.h"
+
+#include <algorithm>
+#include <new>
+
+namespace sysx {
+namespace utils {
+
+namespace {
+
+class new_delete_memory_resource : public memory_resource
+{
+protected:
+  void* do_allocate(size_type bytes, size_type align) override
+  {
+    SYSX_ASSERT(align <= max_align && "over-aligned allocation");
+    return ::operator new(bytes);
+  }
+
+  void do_deallocate(void* p, size_type, size_type) override
+  {
+    ::operator delete(p);
+  }
+
+  bool do_is_equal(memory_resource const& that) const noexcept override
+  {
+    return dynamic_cast<new_delete_memory_resource const*>(&that) != nullptr;
+  }
+};
+
+thread_local memory_resource* default_resource_ = nullptr;
+
+inline std::size_t
+align_up(std::size_t n, std::size_t align)
+{
+  return (n + align - 1) / align * align;
+}
+
+} // anonymous namespace
+
+const memory_resource::size_type memory_resource::max_align;
+const pool_resource::size_type pool_resource::min_block_size;
+const pool_resource::size_type pool_resource::max_block_size;
+
+memory_resource*
+new_delete_resource() noexcept
+{
+  static new_delete_memory_resource instance;
+  return &instance;
+}
+
+memory_resource*
+get_default_resource() noexcept
+{
+  return default_resource_ ? default_resource_ : new_delete_resource();
+}
+
+memory_resource*
+set_default_resource(memory_resource* r) noexcept
+{
+  memory_resource* prev = get_default_resource();
+  default_resource_ = r;
+  return prev;
+}
+
+/* ------------------------- monotonic buffer ------------------------- */
+
+struct monotonic_buffer_resource::chunk
+{
+  chunk* next;
+  size_type size; ///< including this header
+};
+
+static const std::size_t chunk_header_size =
+  align_up(sizeof(void*) + sizeof(std::size_t), memory_resource::max_align);
+
+monotonic_buffer_resource::monotonic_buffer_resource(size_type initial_size,
+                                                     memory_resource* upstream)
+  : mutex_()
+  , upstream_(upstream)
+  , chunks_()
+  , cur_()
+  , left_()
+  , next_size_(std::max<size_type>(initial_size, 64))
+  , allocated_()
+  , reserved_()
+{
+  SYSX_ASSERT(upstream_ != nullptr);
+}
+
+monotonic_buffer_resource::~monotonic_buffer_resource()
+{
+  release();
+}
+
+void
+monotonic_buffer_resource::release()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (chunks_) {
+    chunk* c = chunks_;
+    chunks_ = c->next;
+    upstream_->deallocate(c, c->size);
+  }
+  cur_ = nullptr;
+  left_ = 0;
+  allocated_ = 0;
+  reserved_ = 0;
+}
+
+monotonic_buffer_resource::size_type
+monotonic_buffer_resource::bytes_allocated() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return allocated_;
+}
+
+monotonic_buffer_resource::size_type
+monotonic_buffer_resource::bytes_reserved() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return reserved_;
+}
+
+void*
+monotonic_buffer_resource::do_allocate(size_type bytes, size_type align)
+{
+  SYSX_ASSERT(align <= max_align && "over-aligned allocation");
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  size_type pad = cur_ ? align_up(reinterpret_cast<std::size_t>(cur_), align) -
+                           reinterpret_cast<std::size_t>(cur_)
+                       : 0;
+
+  if (!cur_ || pad + bytes > left_) {
+    size_type size = chunk_header_size + align_up(bytes, max_align);
+    while (next_size_ < size)
+      next_size_ *= 2;
+    size = next_size_;
+    next_size_ *= 2;
+
+    auto c = static_cast<chunk*>(upstream_->allocate(size));
+    c->next = chunks_;
+    c->size = size;
+    chunks_ = c;
+    reserved_ += size;
+
+    cur_ = reinterpret_cast<char*>(c) + chunk_header_size;
+    left_ = size - chunk_header_size;
+    pad = 0;
+  }
+
+  void* ret = cur_ + pad;
+  cur_ += pad + bytes;
+  left_ -= pad + bytes;
+  allocated_ += bytes;
+  return ret;
+}
+
+/* ------------------------------ pools ------------------------------- */
+
+struct pool_resource::block
+{
+  block* next;
+};
+
+struct pool_resource::chunk
+{
+  chunk* next;
+  size_type size;
+};
+
+struct pool_resource::large_block
+{
+  large_block* prev;
+  large_block* next;
+  size_type size; ///< including the header
+};
+
+static const std::size_t pool_chunk_size = 64 * 1024;
+static const std::size_t large_header_size =
+  align_up(sizeof(void*) * 2 + sizeof(std::size_t), memory_resource::max_align);
+
+pool_resource::pool_resource(memory_resource* upstream)
+  : mutex_()
+  , upstream_(upstream)
+  , free_()
+  , chunks_()
+  , large_()
+  , in_use_()
+  , peak_()
+{
+  SYSX_ASSERT(upstream_ != nullptr);
+}
+
+pool_resource::~pool_resource()
+{
+  release();
+}
+
+pool_resource::size_type
+pool_resource::pool_index(size_type bytes)
+{
+  size_type idx = 0;
+  for (size_type sz = min_block_size; sz < bytes; sz *= 2)
+    ++idx;
+  return idx;
+}
+
+void
+pool_resource::release()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (chunks_) {
+    chunk* c = chunks_;
+    chunks_ = c->next;
+    upstream_->deallocate(c, c->size);
+  }
+  while (large_) {
+    large_block* b = large_;
+    large_ = b->next;
+    upstream_->deallocate(b, b->size);
+  }
+  std::fill(free_, free_ + num_pools, nullptr);
+  in_use_ = 0;
+  peak_ = 0;
+}
+
+pool_resource::size_type
+pool_resource::bytes_in_use() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return in_use_;
+}
+
+pool_resource::size_type
+pool_resource::peak_bytes_in_use() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return peak_;
+}
+
+void*
+pool_resource::do_allocate(size_type bytes, size_type align)
+{
+  SYSX_ASSERT(align <= max_align && "over-aligned allocation");
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  in_use_ += bytes;
+  peak_ = std::max(peak_, in_use_);
+
+  if (bytes > max_block_size) {
+    size_type size = large_header_size + bytes;
+    auto b = static_cast<large_block*>(upstream_->allocate(size));
+    b->prev = nullptr;
+    b->next = large_;
+    b->size = size;
+    if (large_)
+      large_->prev = b;
+    large_ = b;
+    return reinterpret_cast<char*>(b) + large_header_size;
+  }
+
+  size_type idx = pool_index(std::max(bytes, align));
+  if (!free_[idx]) {
+    // carve a new chunk into blocks of this size
+    size_type block_size = min_block_size << idx;
+    auto c = static_cast<chunk*>(upstream_->allocate(pool_chunk_size));
+    c->next = chunks_;
+    c->size = pool_chunk_size;
+    chunks_ = c;
+
+    char* p = reinterpret_cast<char*>(c) + chunk_header_size;
+    char* end = reinterpret_cast<char*>(c) + pool_chunk_size;
+    for (; p + block_size <= end; p += block_size) {
+      auto b = reinterpret_cast<block*>(p);
+      b->next = free_[idx];
+      free_[idx] = b;
+    }
+  }
+
+  block* b = free_[idx];
+  free_[idx] = b->next;
+  return b;
+}
+
+void
+pool_resource::do_deallocate(void* p, size_type bytes, size_type align)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  in_use_ -= bytes;
+
+  if (bytes > max_block_size) {
+    auto b = reinterpret_cast<large_block*>(static_cast<char*>(p) -
+                                            large_header_size);
+    if (b->prev)
+      b->prev->next = b->next;
+    else
+      large_ = b->next;
+    if (b->next)
+      b->next->prev = b->prev;
+    upstream_->deallocate(b, b->size);
+    return;
+  }
+
+  auto b = static_cast<block*>(p);
+  size_type idx = pool_index(std::max(bytes, align));
+  b->next = free_[idx];
+  free_[idx] = b;
+}
+
+} // namespace utils
+} // namespace sysx
+
+/* Taf!
+ */
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   quantile_sketch.cpp
+ * \brief  mergeable sketch for weighted quantiles (implementation)
+ * \see    quantile_sketch.h
+ */
+
+#include "tvs/utils/quantile_sketch.h"
+
+#include "tvs/utils/assert.h"
+#include "tvs/utils/report.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sysx {
+namespace utils {
+
+namespace {
+
+/// magnitudes below are counted as zero
+const double min_magnitude = 1e-12;
+
+} // anonymous namespace
+
+/// add the buckets of \a that to \a buckets
+void
+quantile_sketch::merge_buckets(bucket_map& buckets, bucket_map const& that)
+{
+  for (auto const& b : that) {
+    auto& mine = buckets[b.first];
+    mine.weight += b.second.weight;
+    mine.count += b.second.count;
+  }
+}
+
+/// remove the values of \a that from \a b, reset \a b once all are removed
+void
+quantile_sketch::subtract_bucket(bucket& b, bucket const& that)
+{
+  if (b.count <= that.count) {
+    b = bucket();
+  } else {
+    b.count -= that.count;
+    b.weight = std::max(0.0, b.weight - that.weight);
+  }
+}
+
+/// remove the buckets of \a that from \a buckets, drop emptied buckets
+void
+quantile_sketch::subtract_buckets(bucket_map& buckets, bucket_map const& that)
+{
+  for (auto const& b : that) {
+    auto it = buckets.find(b.first);
+    if (it == buckets.end()) // already emptied
+      continue;
+    subtract_bucket(it->second, b.second);
+    if (it->second.count == 0)
+      buckets.erase(it);
+  }
+}
+
+quantile_sketch::quantile_sketch(double relative_accuracy)
+  : accuracy_(relative_accuracy)
+  , gamma_((1 + relative_accuracy) / (1 - relative_accuracy))
+  , log_gamma_(std::log(gamma_))
+  , positive_()
+  , negative_()
+  , zero_()
+  , weight_()
+{
+  SYSX_ASSERT(relative_accuracy > 0.0 && relative_accuracy < 1.0);
+}
+
+int
+quantile_sketch::index(double magnitude) const
+{
+  return static_cast<int>(std::ceil(std::log(magnitude) / log_gamma_));
+}
+
+double
+quantile_sketch::bucket_value(int index) const
+{
+  return 2 * std::pow(gamma_, index) / (gamma_ + 1);
+}
+
+void
+quantile_sketch::add(double value, double weight)
+{
+  if (weight <= 0.0)
+    return;
+
+  bucket& b = value >= min_magnitude
+                ? positive_[index(value)]
+                : value <= -min_magnitude ? negative_[index(-value)] : zero_;
+  b.weight += weight;
+  ++b.count;
+  weight_ += weight;
+}
+
+void
+quantile_sketch::merge(quantile_sketch const& that)
+{
+  SYSX_ASSERT(gamma_ == that.gamma_ && "merging sketches of different accuracy");
+
+  merge_buckets(positive_, that.positive_);
+  merge_buckets(negative_, that.negative_);
+  zero_.weight += that.zero_.weight;
+  zero_.count += that.zero_.count;
+  weight_ += that.weight_;
+}
+
+void
+quantile_sketch::subtract(quantile_sketch const& that)
+{
+  SYSX_ASSERT(gamma_ == that.gamma_ &&
+              "subtracting sketches of different accuracy");
+
+  subtract_buckets(positive_, that.positive_);
+  subtract_buckets(negative_, that.negative_);
+  subtract_bucket(zero_, that.zero_);
+
+  // recompute the total to avoid accumulating rounding errors
+  weight_ = zero_.weight;
+  for (auto const& b : positive_)
+    weight_ += b.second.weight;
+  for (auto const& b : negative_)
+    weight_ += b.second.weight;
+}
+
+double
+quantile_sketch::quantile(double q) const
+{
+  SYSX_ASSERT(q >= 0.0 && q <= 1.0);
+  if (empty())
+    return 0.0;
+
+  // walk the buckets in ascending order of their values
+  double const rank = q * weight_;
+  double seen = 0.0;
+  for (auto it = negative_.rbegin(); it != negative_.rend(); ++it) {
+    seen += it->second.weight;
+    if (seen >= rank)
+      return -bucket_value(it->first);
+  }
+  seen += zero_.weight;
+  if (seen >= rank && zero_.count > 0)
+    return 0.0;
+  for (auto const& b : positive_) {
+    seen += b.second.weight;
+    if (seen >= rank)
+      return bucket_value(b.first);
+  }
+  // rounding of the accumulated weights
+  return positive_.empty() ? (zero_.count > 0 ? 0.0
+                                          : -bucket_value(
+                                              negative_.begin()->first))
+                           : bucket_value(positive_.rbegin()->first);
+}
+
+void
+quantile_sketch::clear()
+{
+  positive_.clear();
+  negative_.clear();
+  zero_ = bucket();
+  weight_ = 0.0;
+}
+
+} // namespace utils
+} // namespace sysx
+
+/* Taf!
+ */
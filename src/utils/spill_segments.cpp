@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   spill_segments.cpp
+ * \brief  FIFO storage in memory-mapped temporary files (implementation)
+ * \see    spill_segments.h
+ */
+
+#include "tvs/utils/spill_segments.h"
+
+#include "tvs/utils/assert.h"
+#include "tvs/utils/report.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SYSX_HAVE_MMAP_ 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace sysx {
+namespace utils {
+
+namespace {
+
+std::string
+spill_directory()
+{
+  for (auto var : { "TVS_SPILL_DIR", "TMPDIR" })
+    if (auto dir = std::getenv(var))
+      if (*dir)
+        return dir;
+  return "/tmp";
+}
+
+} // anonymous namespace
+
+const spill_segments::size_type spill_segments::default_segment_size;
+
+spill_segments::spill_segments(size_type record_size,
+                               size_type record_align,
+                               size_type segment_size)
+  : record_size_((record_size + record_align - 1) / record_align *
+                 record_align)
+  , records_per_segment_(std::max<size_type>(1, segment_size / record_size_))
+  , head_()
+  , tail_()
+  , size_()
+  , segments_()
+{}
+
+spill_segments::~spill_segments()
+{
+  for (auto& seg : segments_)
+    release(seg);
+}
+
+void*
+spill_segments::push_back()
+{
+  if (segments_.empty() || tail_ == records_per_segment_) {
+    segments_.push_back(allocate());
+    tail_ = 0;
+  }
+  ++size_;
+  return segments_.back().data + record_size_ * tail_++;
+}
+
+void
+spill_segments::pop_front()
+{
+  SYSX_ASSERT(!empty());
+  --size_;
+
+  // segment completely consumed (or no records left at all)
+  if (++head_ == records_per_segment_ || size_ == 0) {
+    release(segments_.front());
+    segments_.pop_front();
+    head_ = 0;
+    if (segments_.empty())
+      tail_ = 0;
+  }
+}
+
+void*
+spill_segments::front()
+{
+  SYSX_ASSERT(!empty());
+  return segments_.front().data + record_size_ * head_;
+}
+
+void const*
+spill_segments::front() const
+{
+  SYSX_ASSERT(!empty());
+  return segments_.front().data + record_size_ * head_;
+}
+
+spill_segments::segment
+spill_segments::allocate()
+{
+  segment seg;
+  auto bytes = record_size_ * records_per_segment_;
+#ifdef SYSX_HAVE_MMAP_
+  auto path = spill_directory() + "/tvs-spill-XXXXXX";
+  seg.fd = ::mkstemp(&path[0]);
+  if (seg.fd < 0) {
+    SYSX_REPORT_FATAL(sysx::report::plain_msg)
+      << "Cannot create spill file '" << path << "': " << std::strerror(errno);
+  }
+  ::unlink(path.c_str()); // released on close
+
+  void* data = MAP_FAILED;
+  if (::ftruncate(seg.fd, static_cast<off_t>(bytes)) == 0)
+    data = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, seg.fd, 0);
+  if (data == MAP_FAILED) {
+    auto err = errno;
+    ::close(seg.fd);
+    SYSX_REPORT_FATAL(sysx::report::plain_msg)
+      << "Cannot map spill file: " << std::strerror(err);
+  }
+  seg.data = static_cast<char*>(data);
+#else
+  seg.fd = -1;
+  seg.data = static_cast<char*>(::operator new(bytes));
+#endif
+  return seg;
+}
+
+void
+spill_segments::release(segment& seg)
+{
+#ifdef SYSX_HAVE_MMAP_
+  ::munmap(seg.data, record_size_ * records_per_segment_);
+  ::close(seg.fd);
+#else
+  ::operator delete(seg.data);
+#endif
+  seg.data = nullptr;
+}
+
+} // namespace utils
+} // namespace sysx
+
+/* Taf!
+ */
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file   thread_pool.cpp
+ * \brief  simple work-stealing thread pool (implementation)
+ * \see    thread_pool.h
+ */
+
+#include "tvs/utils/thread_pool.h"
+
+namespace sysx {
+namespace utils {
+
+thread_pool::thread_pool(unsigned num_workers)
+  : queues_()
+  , workers_()
+  , queued_(0)
+  , pending_(0)
+  , error_()
+  , stop_(false)
+{
+  // queue 0 belongs to the calling thread
+  for (unsigned i = 0; i <= num_workers; ++i)
+    queues_.emplace_back(new queue_type());
+
+  for (unsigned i = 1; i <= num_workers; ++i)
+    workers_.emplace_back(&thread_pool::work, this, i);
+}
+
+thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+
+  for (auto& w : workers_)
+    w.join();
+}
+
+void
+thread_pool::run(std::vector<task_type>& tasks)
+{
+  if (tasks.empty())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ = tasks.size();
+    error_ = nullptr;
+
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+      auto& q = *queues_[i % queues_.size()];
+      std::lock_guard<std::mutex> qlock(q.mutex);
+      q.tasks.push_back(&tasks[i]);
+    }
+    queued_ = tasks.size();
+  }
+  work_cv_.notify_all();
+
+  // participate until there is nothing left to steal
+  task_type* task = nullptr;
+  while (try_acquire(0, task))
+    execute(*task);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return pending_ == 0; });
+
+  if (error_) {
+    std::exception_ptr error;
+    std::swap(error, error_);
+    std::rethrow_exception(error);
+  }
+}
+
+void
+thread_pool::work(std::size_t idx)
+{
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_cv_.wait(lock, [this] { return stop_ || queued_ > 0; });
+      if (stop_)
+        return;
+    }
+
+    task_type* task = nullptr;
+    while (try_acquire(idx, task))
+      execute(*task);
+  }
+}
+
+bool
+thread_pool::try_acquire(std::size_t idx, task_type*& task)
+{
+  // own queue first (LIFO)
+  {
+    auto& q = *queues_[idx];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (!q.tasks.empty()) {
+      task = q.tasks.back();
+      q.tasks.pop_back();
+      --queued_;
+      return true;
+    }
+  }
+
+  // steal from the other queues (FIFO)
+  for (std::size_t i = 1; i < queues_.size(); ++i) {
+    auto& q = *queues_[(idx + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (!q.tasks.empty()) {
+      task = q.tasks.front();
+      q.tasks.pop_front();
+      --queued_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+thread_pool::execute(task_type& task)
+{
+  try {
+    task();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!error_)
+      error_ = std::current_exception();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (--pending_ == 0)
+    done_cv_.notify_all();
+}
+
+} // namespace utils
+} // namespace sysx
+
+/* Taf!
+ */
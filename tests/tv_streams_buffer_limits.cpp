@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timed_stream_fixture.h"
+
+#include "tvs/tracing.h"
+
+#include "tvs/utils/spill_segments.h"
+
+#include "gtest/gtest.h"
+
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+
+/// bounded reader buffers (the fixture's reader never consumes)
+class BufferLimits
+  : public timed_stream_fixture<int, tracing::timed_state_traits<int>>
+{
+protected:
+  void push_values(int n)
+  {
+    for (int i = 1; i <= n; ++i)
+      writer.push(i, dur);
+  }
+};
+
+TEST_F(BufferLimits, UnboundedByDefault)
+{
+  push_values(5);
+  writer.commit();
+
+  auto stats = reader.statistics();
+  EXPECT_EQ(tracing::buffer_policy::unbounded, reader.limit_policy());
+  EXPECT_EQ(5u, stats.count);
+  EXPECT_EQ(5u, stats.high_water);
+  EXPECT_EQ(dur * 5, stats.lag);
+  EXPECT_EQ(0u, stats.dropped);
+}
+
+// dropped tuples are replaced by a single empty tuple of the same duration
+TEST_F(BufferLimits, DropOldest)
+{
+  reader.set_buffer_limit(3, tracing::buffer_policy::drop_oldest);
+  push_values(5);
+  writer.commit();
+
+  EXPECT_EQ(3u, reader.count());
+  EXPECT_EQ(dur * 5, reader.available_duration());
+  EXPECT_EQ(0, reader.get());
+  EXPECT_EQ(dur * 3, reader.front_duration());
+
+  reader.pop();
+  EXPECT_EQ(4, reader.get());
+  EXPECT_EQ(tracing::time_type(dur * 3), reader.local_time());
+
+  auto stats = reader.statistics();
+  EXPECT_EQ(3u, stats.dropped);
+  EXPECT_EQ(5u, stats.high_water);
+}
+
+// tuples split by the reader are joined again before dropping any of them
+TEST_F(BufferLimits, Coalesce)
+{
+  writer.push(1, dur * 2);
+  writer.push(2, dur);
+  writer.commit();
+  reader.front(dur);
+  EXPECT_EQ(3u, reader.count());
+
+  reader.set_buffer_limit(2, tracing::buffer_policy::coalesce);
+  EXPECT_EQ(2u, reader.count());
+  EXPECT_EQ(1, reader.get());
+  EXPECT_EQ(dur * 2, reader.front_duration());
+
+  auto stats = reader.statistics();
+  EXPECT_EQ(1u, stats.coalesced);
+  EXPECT_EQ(0u, stats.dropped);
+
+  // distinct values cannot be joined
+  push_values(3);
+  writer.commit();
+  EXPECT_EQ(2u, reader.count());
+  EXPECT_EQ(dur * 6, reader.available_duration());
+  EXPECT_EQ(4u, reader.statistics().dropped);
+}
+
+TEST_F(BufferLimits, StreamLimit)
+{
+  writer.stream().set_buffer_limit(2);
+  EXPECT_EQ(2u, reader.buffer_limit());
+
+  reader_type late("late_reader", writer.name());
+  EXPECT_EQ(2u, late.buffer_limit());
+  EXPECT_EQ(tracing::buffer_policy::drop_oldest, late.limit_policy());
+
+  push_values(4);
+  writer.commit();
+  EXPECT_EQ(2u, reader.count());
+  EXPECT_EQ(2u, late.count());
+}
+
+/// temporarily registered model synchronisation function
+struct model_sync_guard
+{
+  explicit model_sync_guard(tracing::host::sync_fn_type fn)
+  {
+    tracing::register_sync(std::move(fn));
+  }
+
+  ~model_sync_guard() { tracing::register_sync(nullptr); }
+};
+
+/// temporarily registered back-pressure function
+struct block_sync_guard
+{
+  explicit block_sync_guard(tracing::host::sync_fn_type fn)
+    : prev(tracing::register_block_sync(std::move(fn)))
+  {}
+
+  ~block_sync_guard() { tracing::register_block_sync(std::move(prev)); }
+
+  tracing::host::sync_fn_type prev;
+};
+
+// blocking readers keep all tuples and hold back sync_with_model()
+TEST_F(BufferLimits, Block)
+{
+  int syncs = 0, blocks = 0;
+  model_sync_guard guard([&](tracing::time_type const&) { ++syncs; });
+  block_sync_guard block_guard([&](tracing::time_type const& until) {
+    EXPECT_EQ(writer.local_time(), until);
+    ++blocks;
+    if (reader.available())
+      reader.pop();
+  });
+
+  reader.set_buffer_limit(2, tracing::buffer_policy::block);
+  push_values(5);
+  writer.commit();
+  EXPECT_EQ(5u, reader.count());
+  EXPECT_TRUE(reader.blocking());
+
+  tracing::host::sync_with_model(writer.local_time());
+  EXPECT_FALSE(reader.blocking());
+  EXPECT_EQ(2u, reader.count());
+  EXPECT_EQ(1, syncs);
+  EXPECT_EQ(3, blocks);
+}
+
+// the synchronisation is only held back a bounded number of times
+TEST_F(BufferLimits, BlockBounded)
+{
+  int syncs = 0, blocks = 0;
+  model_sync_guard guard([&](tracing::time_type const&) { ++syncs; });
+  block_sync_guard block_guard([&](tracing::time_type const&) {
+    ++blocks;
+    if (reader.available())
+      reader.pop();
+  });
+
+  reader.set_buffer_limit(2, tracing::buffer_policy::block);
+  push_values(20);
+  writer.commit();
+
+  tracing::host::sync_with_model(writer.local_time());
+  EXPECT_TRUE(reader.blocking());
+  EXPECT_EQ(1, syncs);
+  EXPECT_EQ(8, blocks);
+  EXPECT_EQ(12u, reader.count());
+}
+
+// without a back-pressure function, the model is synchronised only once
+TEST_F(BufferLimits, BlockWithoutHook)
+{
+  int syncs = 0;
+  model_sync_guard guard([&](tracing::time_type const&) {
+    ++syncs;
+    if (reader.available())
+      reader.pop();
+  });
+
+  reader.set_buffer_limit(2, tracing::buffer_policy::block);
+  push_values(5);
+  writer.commit();
+
+  tracing::host::sync_with_model(writer.local_time());
+  EXPECT_TRUE(reader.blocking());
+  EXPECT_EQ(1, syncs);
+  EXPECT_EQ(4u, reader.count());
+}
+
+// spilled tuples are transparently paged in again while consuming
+TEST_F(BufferLimits, Spill)
+{
+  reader.set_buffer_limit(4, tracing::buffer_policy::spill);
+  push_values(10);
+  writer.commit();
+
+  auto stats = reader.statistics();
+  EXPECT_EQ(10u, stats.count);
+  EXPECT_EQ(8u, stats.spilled);
+  EXPECT_EQ(dur * 10, stats.lag);
+
+  // appended behind the spilled tuples
+  writer.push(11, dur);
+  writer.commit();
+  EXPECT_EQ(9u, reader.statistics().spilled);
+
+  auto range = reader.range(dur * 3);
+  EXPECT_EQ(3, std::distance(range.begin(), range.end()));
+
+  for (int i = 1; i <= 11; ++i) {
+    ASSERT_TRUE(reader.available());
+    EXPECT_EQ(i, reader.get());
+    reader.pop();
+  }
+  EXPECT_FALSE(reader.available());
+  EXPECT_EQ(0u, reader.statistics().spilled);
+  EXPECT_EQ(tracing::time_type(dur * 11), reader.local_time());
+}
+
+// accessors of a non-const reader page in the spilled tuples
+TEST_F(BufferLimits, SpillAccessors)
+{
+  reader.set_buffer_limit(4, tracing::buffer_policy::spill);
+  push_values(10);
+  writer.commit();
+  EXPECT_EQ(8u, reader.statistics().spilled);
+
+  std::stringstream os;
+  reader.print(os);
+  EXPECT_NE(std::string::npos, os.str().find("(+8 spilled)"));
+
+  auto const& view = reader;
+  EXPECT_EQ(1, view.get(tracing::timed_duration::zero_time));
+  EXPECT_EQ(2, view.get(dur));
+
+  EXPECT_EQ(10, std::distance(reader.begin(), reader.end()));
+  EXPECT_EQ(0u, reader.statistics().spilled);
+  EXPECT_EQ(10, view.get(dur * 9));
+}
+
+TEST(SpillSegments, ReleaseConsumedSegments)
+{
+  sysx::utils::spill_queue<int> queue(4 * sizeof(int));
+
+  for (int i = 0; i < 10; ++i)
+    queue.push_back(i);
+  EXPECT_EQ(10u, queue.size());
+  EXPECT_EQ(3u, queue.segments());
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(i, queue.front());
+    queue.pop_front();
+  }
+  EXPECT_EQ(2u, queue.segments());
+
+  while (!queue.empty())
+    queue.pop_front();
+  EXPECT_EQ(0u, queue.segments());
+}
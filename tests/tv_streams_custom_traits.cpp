@@ -22,6 +22,7 @@
 #include "gtest/gtest.h"
 
 #include <map>
+#include <set>
 
 /// Example usage of custom traits
 
@@ -144,3 +145,315 @@ TEST_F(CustomTraitsSemantics, CheckMergeBothInfinite)
   // here the second call overwrites the inf tuple value in the stream
   expect_processor_output("0 s:(NONE,3 s)\n");
 }
+
+//////////// CHECK TOLERANT JOIN POLICIES /////////////
+
+// noisy power values within 1e-3 W are joined, keeping the first value
+struct absolute_traits : tracing::timed_state_traits<double>
+{
+  typedef tracing::timed_join_policy_absolute<double, std::ratio<1, 1000>>
+    join_policy;
+};
+
+// values within 1% are joined to their duration-weighted average
+struct relative_traits : tracing::timed_state_traits<double>
+{
+  typedef tracing::timed_join_policy_relative<
+    double,
+    std::ratio<1, 100>,
+    tracing::timed_join_value_average<double>>
+    join_policy;
+};
+
+// values in the same 0.5 W bucket are joined
+struct quantized_traits : tracing::timed_state_traits<double>
+{
+  typedef tracing::timed_join_policy_quantized<double, std::ratio<1, 2>>
+    join_policy;
+};
+
+// power values per second within 1% are joined, the values are summed
+struct summing_traits : tracing::timed_process_traits<double>
+{
+  typedef tracing::timed_join_policy_relative<
+    double,
+    std::ratio<1, 100>,
+    tracing::timed_join_value_sum<double>>
+    join_policy;
+};
+
+struct AbsoluteJoinSemantics
+  : public timed_stream_fixture<double, absolute_traits>
+{
+};
+
+struct RelativeJoinSemantics
+  : public timed_stream_fixture<double, relative_traits>
+{
+};
+
+struct QuantizedJoinSemantics
+  : public timed_stream_fixture<double, quantized_traits>
+{
+};
+
+struct SummingJoinSemantics
+  : public timed_stream_fixture<double, summing_traits>
+{
+};
+
+TEST_F(AbsoluteJoinSemantics, CheckJoin)
+{
+  writer.push(1.0, dur);
+  writer.push(1.0004, dur);
+  writer.push(0.9996, dur);
+  writer.push(1.01, dur);
+  writer.commit();
+  expect_processor_output("0 s:(1,3 s)\n"
+                          "3 s:(1.01,1 s)\n");
+  EXPECT_EQ(2u, reader.count());
+}
+
+TEST_F(RelativeJoinSemantics, CheckJoin)
+{
+  writer.push(100.0, dur * 3);
+  writer.push(100.4, dur);
+  writer.push(110.0, dur);
+  writer.commit();
+  expect_processor_output("0 s:(100.1,4 s)\n"
+                          "4 s:(110,1 s)\n");
+}
+
+TEST_F(QuantizedJoinSemantics, CheckJoin)
+{
+  writer.push(1.1, dur);
+  writer.push(1.4, dur);
+  writer.push(1.6, dur);
+  writer.push(1.9, dur);
+  writer.push(-0.1, dur);
+  writer.commit();
+  expect_processor_output("0 s:(1.1,2 s)\n"
+                          "2 s:(1.6,2 s)\n"
+                          "4 s:(-0.1,1 s)\n");
+}
+
+TEST_F(SummingJoinSemantics, CheckJoin)
+{
+  writer.push(1.0, dur);
+  writer.push(1.004, dur);
+  writer.push(2.2, dur * 2);
+  writer.commit();
+  expect_processor_output("0 s:(2.004,2 s)\n"
+                          "2 s:(2.2,2 s)\n");
+}
+
+TEST_F(SummingJoinSemantics, SplitJoined)
+{
+  writer.push(1.0, dur);
+  writer.push(1.0, dur);
+  writer.commit();
+  reader.front(dur);
+  EXPECT_DOUBLE_EQ(1.0, reader.front().value());
+}
+
+//////////// CHECK ZERO-TIME POLICIES /////////////
+
+struct absorbing_traits : tracing::timed_state_traits<int>
+{
+  typedef tracing::timed_zero_time_policy_absorb<int> zero_time_policy;
+};
+
+struct ZeroTimeAbsorbSemantics
+  : public timed_stream_fixture<int, absorbing_traits>
+{
+};
+
+TEST_F(ZeroTimeAbsorbSemantics, PushZeroTime)
+{
+  writer.push(4711, dur);
+  writer.push(4712, zero_time);
+  writer.push(4713, dur);
+  writer.commit(dur * 2);
+  EXPECT_EQ(dur * 2, writer.end_time());
+
+  expect_processor_output("0 s:(4711,1 s)\n"
+                          "1 s:(4713,1 s)\n");
+}
+
+TEST_F(ZeroTimeAbsorbSemantics, PushZeroTimeAtEnd)
+{
+  writer.push(4711, dur);
+  writer.push(4712, zero_time);
+  writer.commit(dur);
+  EXPECT_EQ(dur, writer.end_time());
+
+  expect_processor_output("0 s:(4711,1 s)\n");
+  EXPECT_EQ(1u, reader.count());
+}
+
+TEST_F(ZeroTimeAbsorbSemantics, JoinAcrossZeroTime)
+{
+  writer.push(4711, dur);
+  writer.push(4712, zero_time);
+  writer.push(4711, dur);
+  writer.commit();
+
+  expect_processor_output("0 s:(4711,2 s)\n");
+}
+
+TEST_F(ZeroTimeAbsorbSemantics, PushZeroTimeWithOffset)
+{
+  writer.push(dur, 4712, zero_time);
+  writer.push(zero_time, 4711, dur * 2);
+  writer.commit(dur * 2);
+
+  expect_processor_output("0 s:(4711,2 s)\n");
+}
+
+struct absorbing_event_traits : tracing::timed_event_traits<std::set<int>>
+{
+  typedef tracing::timed_zero_time_policy_absorb<std::set<int>>
+    zero_time_policy;
+};
+
+struct ZeroTimeAbsorbEventSemantics
+  : public timed_stream_fixture<std::set<int>, absorbing_event_traits>
+{
+};
+
+TEST_F(ZeroTimeAbsorbEventSemantics, FoldIntoSuccessor)
+{
+  writer.push({ 1 }, dur);
+  writer.push({ 2 }, zero_time);
+  writer.push({ 3 }, zero_time);
+  writer.push({ 4 }, dur);
+  writer.commit(dur * 2);
+
+  expect_processor_output("0 s:({ 1 },1 s)\n"
+                          "1 s:({ 2, 3, 4 },1 s)\n");
+  EXPECT_EQ(2u, reader.count());
+}
+
+TEST_F(ZeroTimeAbsorbEventSemantics, FoldAcrossCommit)
+{
+  writer.push({ 1 }, dur);
+  writer.push({ 2 }, zero_time);
+  writer.commit(dur);
+  expect_processor_output("0 s:({ 1 },1 s)\n");
+
+  writer.push({ 3 }, dur);
+  writer.commit();
+  expect_processor_output("1 s:({ 2, 3 },1 s)\n");
+}
+
+TEST_F(ZeroTimeAbsorbEventSemantics, FoldWithOffset)
+{
+  writer.push(dur, { 2 }, zero_time);
+  writer.push(zero_time, { 1 }, dur * 2);
+  writer.commit(dur * 2);
+
+  expect_processor_output("0 s:({ - },1 s)\n"
+                          "1 s:({ 1, 2 },1 s)\n");
+}
+
+//////////// CHECK MERGE POLICIES /////////////
+
+template<template<typename> class MergePolicy>
+struct merging_traits : tracing::timed_state_traits<double>
+{
+  typedef MergePolicy<double> merge_policy;
+};
+
+struct MaximumMergeSemantics
+  : public timed_stream_fixture<
+      double,
+      merging_traits<tracing::timed_merge_policy_maximum>>
+{
+};
+
+struct AverageMergeSemantics
+  : public timed_stream_fixture<
+      double,
+      merging_traits<tracing::timed_merge_policy_average>>
+{
+};
+
+struct OverrideMergeSemantics
+  : public timed_stream_fixture<
+      double,
+      merging_traits<tracing::timed_merge_policy_override>>
+{
+};
+
+TEST_F(MaximumMergeSemantics, OverlappingPushes)
+{
+  writer.push(zero_time, 2.0, dur * 3);
+  writer.push(dur, 5.0, dur);
+  writer.push(dur * 2, 1.0, dur * 2);
+  writer.commit(dur * 4);
+
+  expect_processor_output("0 s:(2,1 s)\n"
+                          "1 s:(5,1 s)\n"
+                          "2 s:(2,1 s)\n"
+                          "3 s:(1,1 s)\n");
+}
+
+TEST_F(MaximumMergeSemantics, PushOrder)
+{
+  writer.push(dur, 4.0, dur * 2);
+  writer.push(zero_time, 3.0, dur * 2);
+  writer.push(zero_time, 6.0, dur);
+  writer.commit(dur * 3);
+
+  expect_processor_output("0 s:(6,1 s)\n"
+                          "1 s:(4,2 s)\n");
+}
+
+TEST_F(MaximumMergeSemantics, ReversedPushOrder)
+{
+  writer.push(zero_time, 6.0, dur);
+  writer.push(zero_time, 3.0, dur * 2);
+  writer.push(dur, 4.0, dur * 2);
+  writer.commit(dur * 3);
+
+  expect_processor_output("0 s:(6,1 s)\n"
+                          "1 s:(4,2 s)\n");
+}
+
+TEST_F(AverageMergeSemantics, OverlappingPushes)
+{
+  writer.push(zero_time, 2.0, dur * 2);
+  writer.push(dur, 4.0, dur * 2);
+  writer.commit(dur * 3);
+
+  expect_processor_output("0 s:(2,1 s)\n"
+                          "1 s:(3,1 s)\n"
+                          "2 s:(4,1 s)\n");
+}
+
+// pairwise means: later pushes weigh more, (3 + 3) / 2 and 6 yield 4.5
+TEST_F(AverageMergeSemantics, PushOrder)
+{
+  writer.push(zero_time, 3.0, dur);
+  writer.push(zero_time, 3.0, dur);
+  writer.push(zero_time, 6.0, dur);
+  writer.commit(dur);
+
+  expect_processor_output("0 s:(4.5,1 s)\n");
+}
+
+TEST_F(OverrideMergeSemantics, OverlappingPushes)
+{
+  // the later push wins, also if it is the shorter tuple
+  writer.push(zero_time, 2.0, dur * 3);
+  writer.push(dur, 5.0, dur);
+  // ... and if it is the longer tuple
+  writer.push(dur * 2, 7.0, dur * 2);
+  writer.push(dur * 3, 1.0, dur * 2);
+  writer.commit(dur * 5);
+
+  expect_processor_output("0 s:(2,1 s)\n"
+                          "1 s:(5,1 s)\n"
+                          "2 s:(7,1 s)\n"
+                          "3 s:(1,2 s)\n");
+}
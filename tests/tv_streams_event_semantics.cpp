@@ -86,6 +86,17 @@ TEST_F(StreamEventSemantics, PushSemantics)
                           "@2 s: { 10 }\n");
 }
 
+TEST_F(StreamEventSemantics, PushZeroAfterFuture)
+{
+  // merge a second event at zero offset into an existing zero-time tuple
+  writer.push(1, 5 * dur);
+  writer.push(2, zero_time);
+  writer.push(3, zero_time);
+  writer.commit();
+  expect_processor_output("@0 s: { 2, 3 }\n"
+                          "@5 s: { 1 }\n");
+}
+
 TEST_F(StreamEventSemantics, PartialCommit)
 {
   // Push two events to an absolute time point which need to be 'merged'
@@ -241,3 +252,96 @@ TEST_F(StreamEventSemantics, RoundingErrorTests2)
 }
 
 #endif
+
+/// event streams with different set types
+template<typename Set>
+class EventSetSemantics : public timed_stream_fixture_b
+{
+protected:
+  using writer_type = tracing::timed_event_writer<int, Set>;
+  using reader_type = typename writer_type::stream_type::reader_type;
+
+  EventSetSemantics()
+    : writer("set_writer", tracing::STREAM_CREATE)
+    , reader("set_reader", writer.name())
+  {}
+
+  std::string consume()
+  {
+    std::stringstream strs;
+    while (reader.available()) {
+      strs << reader.front_duration() << ":";
+      for (auto ev : reader.get())
+        strs << " " << ev;
+      strs << ";";
+      reader.pop();
+    }
+    return strs.str();
+  }
+
+  writer_type writer;
+  reader_type reader;
+};
+
+using EventSetTypes =
+  ::testing::Types<std::set<int>,
+                   tracing::small_event_set<int, 2>,
+                   tracing::bitmask_event_set<int>>;
+TYPED_TEST_CASE(EventSetSemantics, EventSetTypes);
+
+TYPED_TEST(EventSetSemantics, UnionMerge)
+{
+  auto dur = this->dur;
+  this->writer.push(7, dur);
+  this->writer.push(3, dur);
+  this->writer.push(42, dur);
+  this->writer.push(3, dur);
+  this->writer.push(1, dur * 2);
+  this->writer.commit();
+
+  EXPECT_EQ("1 s: 3 7 42;1 s: 1;", this->consume());
+}
+
+TYPED_TEST(EventSetSemantics, SplitDecay)
+{
+  auto dur = this->dur;
+  this->writer.push(5, dur * 2);
+  this->writer.push(9, dur);
+  this->writer.commit();
+
+  EXPECT_EQ("1 s: 9;1 s: 5;", this->consume());
+}
+
+TEST(EventSets, SmallSetGrowth)
+{
+  tracing::small_event_set<int, 2> set{ 4, 2 };
+  tracing::small_event_set<int, 2> other{ 3, 1, 4 };
+  EXPECT_EQ(2u, set.size());
+
+  set.merge(other);
+  EXPECT_EQ((tracing::small_event_set<int, 2>{ 1, 2, 3, 4 }), set);
+  EXPECT_EQ(1u, set.count(3));
+  EXPECT_EQ(0u, set.count(5));
+
+  std::stringstream strs;
+  strs << set;
+  EXPECT_EQ("{ 1, 2, 3, 4 }", strs.str());
+}
+
+TEST(EventSets, Bitmask)
+{
+  enum class irq
+  {
+    timer,
+    uart,
+    dma = 63
+  };
+  tracing::bitmask_event_set<irq> set{ irq::dma, irq::timer };
+  EXPECT_EQ(2u, set.size());
+  EXPECT_EQ(irq::timer, *set.begin());
+  EXPECT_EQ(0u, set.count(irq::uart));
+
+  set.merge({ irq::uart });
+  EXPECT_EQ(3u, set.size());
+  EXPECT_EQ((std::uint64_t(1) << 63) | 3u, set.mask());
+}
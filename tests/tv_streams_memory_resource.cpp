@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timed_stream_fixture.h"
+
+#include "tvs/tracing.h"
+
+#include "tvs/utils/memory_resource.h"
+
+#include "gtest/gtest.h"
+
+using sysx::utils::memory_resource_scope;
+using sysx::utils::monotonic_buffer_resource;
+using sysx::utils::pool_resource;
+
+typedef tracing::timed_state_traits<int> traits_type;
+typedef tracing::timed_sequence<int, traits_type> sequence_type;
+typedef tracing::timed_stream<int, traits_type> stream_type;
+
+/// streams and readers created within a resource scope
+class MemoryResource : public timed_stream_fixture_b
+{
+protected:
+  MemoryResource()
+    : pool()
+    , scope(pool)
+    , writer("writer", tracing::STREAM_CREATE)
+    , reader("reader", writer.name())
+  {}
+
+  pool_resource pool;
+  memory_resource_scope scope;
+  stream_type::writer_type writer;
+  stream_type::reader_type reader;
+};
+
+TEST_F(MemoryResource, DefaultResource)
+{
+  auto* global = sysx::utils::new_delete_resource();
+  monotonic_buffer_resource arena;
+
+  EXPECT_EQ(&pool, sysx::utils::get_default_resource());
+  {
+    memory_resource_scope inner(arena);
+    EXPECT_EQ(&arena, sysx::utils::get_default_resource());
+    EXPECT_EQ(&arena, sequence_type().resource());
+  }
+  EXPECT_EQ(&pool, sysx::utils::get_default_resource());
+  EXPECT_EQ(&pool, reader.resource());
+
+  auto* prev = sysx::utils::set_default_resource(nullptr);
+  EXPECT_EQ(&pool, prev);
+  EXPECT_EQ(global, sysx::utils::get_default_resource());
+  sysx::utils::set_default_resource(prev);
+}
+
+TEST_F(MemoryResource, StreamBuffers)
+{
+  auto baseline = pool.bytes_in_use();
+
+  for (int i = 0; i < 100; ++i)
+    writer.push(i, dur);
+  writer.commit();
+
+  EXPECT_EQ(100u, reader.count());
+  EXPECT_LT(baseline, pool.bytes_in_use());
+  EXPECT_LE(pool.bytes_in_use(), pool.peak_bytes_in_use());
+
+  reader.pop_all();
+  EXPECT_EQ(tracing::time_type(dur * 100), reader.local_time());
+}
+
+// processors allocate their readers and writers from their own resource
+TEST_F(MemoryResource, ProcessorInputs)
+{
+  monotonic_buffer_resource arena;
+
+  memory_resource_scope inner(arena);
+  test_printer<int> printer;
+  {
+    memory_resource_scope outer(pool);
+    auto in = printer.in(writer);
+    EXPECT_EQ(&arena, printer.resource());
+    EXPECT_EQ(&arena, in->resource());
+  }
+  EXPECT_LT(0u, arena.bytes_allocated());
+}
+
+class MemoryResources : public timed_stream_fixture_b
+{};
+
+TEST_F(MemoryResources, SwapAcrossResources)
+{
+  pool_resource pool_a, pool_b;
+  sequence_type a(&pool_a), b(&pool_b);
+
+  a.push_back(1, dur);
+  b.push_back(2, dur * 2);
+  b.push_back(3, dur * 3);
+
+  a.swap(b);
+  EXPECT_EQ(&pool_a, a.resource());
+  EXPECT_EQ(&pool_b, b.resource());
+  EXPECT_EQ(2u, a.size());
+  EXPECT_EQ(1u, b.size());
+  EXPECT_EQ(2, a.front().value());
+  EXPECT_EQ(dur * 5, a.duration());
+
+  b.move_back(a);
+  EXPECT_EQ(&pool_b, b.resource());
+  EXPECT_EQ(3u, b.size());
+  EXPECT_TRUE(a.empty());
+}
+
+TEST_F(MemoryResources, MonotonicRelease)
+{
+  monotonic_buffer_resource arena(128);
+
+  void* p = arena.allocate(24, 8);
+  void* q = arena.allocate(200, 16);
+  EXPECT_NE(p, q);
+  EXPECT_EQ(0u, reinterpret_cast<std::size_t>(q) % 16);
+  EXPECT_EQ(224u, arena.bytes_allocated());
+  EXPECT_LE(224u, arena.bytes_reserved());
+
+  arena.deallocate(p, 24, 8); // no-op
+  arena.release();
+  EXPECT_EQ(0u, arena.bytes_allocated());
+  EXPECT_EQ(0u, arena.bytes_reserved());
+}
+
+TEST_F(MemoryResources, PoolReuse)
+{
+  pool_resource pool;
+
+  void* p = pool.allocate(40);
+  pool.deallocate(p, 40);
+  void* q = pool.allocate(64); // same size class
+  EXPECT_EQ(p, q);
+
+  void* large = pool.allocate(10000);
+  EXPECT_EQ(10064u, pool.bytes_in_use());
+  pool.deallocate(large, 10000);
+  pool.deallocate(q, 64);
+  EXPECT_EQ(0u, pool.bytes_in_use());
+  EXPECT_EQ(10064u, pool.peak_bytes_in_use());
+}
+
+/* Taf!
+ */
@@ -170,6 +170,34 @@ TEST_F(StreamProcessSemantics, PushOffsetSmallDuration)
                           "5 s:(0,1 s)\n");
 }
 
+// zero-time tuples at the offset precede the tuples pushed to the offset
+TEST_F(StreamProcessSemantics, PushOffsetZeroDuration)
+{
+  writer.push(dur, 5, zero_time);
+  writer.push(dur, 7, dur * 2);
+  EXPECT_EQ(zero_time, writer.duration());
+
+  writer.commit(dur * 3);
+  expect_processor_output("0 s:(0,1 s)\n"
+                          "1 s:(5,0 s)\n"
+                          "1 s:(7,2 s)\n");
+}
+
+TEST_F(StreamProcessSemantics, PushOffsetZeroDurationSplit)
+{
+  writer.push(dur, 5, zero_time);
+  writer.push(dur, 7, dur * 2);
+  writer.push(dur * 2, 1, dur);
+  writer.push(dur, 3, zero_time);
+
+  writer.commit(dur * 3);
+  expect_processor_output("0 s:(0,1 s)\n"
+                          "1 s:(5,0 s)\n"
+                          "1 s:(3,0 s)\n"
+                          "1 s:(3.5,1 s)\n"
+                          "2 s:(4.5,1 s)\n");
+}
+
 TEST_F(StreamProcessSemantics, PushDuration)
 {
   writer.push(test_tuple);
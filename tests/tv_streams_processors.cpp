@@ -0,0 +1,763 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timed_stream_fixture.h"
+
+#include "tvs/tracing.h"
+
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <sstream>
+#include <string>
+
+/// processors between a state input stream and printed output streams
+class Processors : public timed_stream_fixture_b
+{
+protected:
+  typedef tracing::timed_state_traits<int> state_traits;
+  typedef tracing::timed_process_traits<double> process_traits;
+  typedef tracing::timed_stream<int, state_traits> state_stream;
+  typedef tracing::timed_stream<double, process_traits> process_stream;
+
+  Processors()
+    : writer("writer", tracing::STREAM_CREATE)
+  {}
+
+  template<typename Printer>
+  static std::string output(Printer& printer)
+  {
+    std::stringstream str;
+    printer.print(str);
+    printer.clear();
+    return str.str();
+  }
+
+  state_stream::writer_type writer;
+};
+
+TEST_F(Processors, PipelineStages)
+{
+  state_stream out("out");
+  test_printer<int> printer;
+  printer.in(out);
+
+  auto proc = tracing::pipeline(writer)
+                .map([](int v) { return v * 2; })
+                .filter([](int v) { return v != 4; })
+                .scan([](int acc, int v) { return acc + v; }, 100)
+                .to(out);
+
+  writer.push(1, dur);
+  writer.push(2, dur);
+  writer.push(3, dur * 2);
+  writer.commit();
+
+  // the filtered tuple is replaced by the empty value
+  EXPECT_EQ("0 s:(102,1 s)\n1 s:(0,1 s)\n2 s:(108,2 s)\n", output(printer));
+
+  writer.push(5, dur);
+  writer.commit();
+  EXPECT_EQ("4 s:(118,1 s)\n", output(printer));
+}
+
+TEST_F(Processors, PipelineConversion)
+{
+  process_stream out("out");
+  test_printer<double> printer;
+  printer.in(out);
+
+  auto proc =
+    tracing::pipeline(writer).map([](int v) { return v / 4.0; }).to(out);
+
+  writer.push(1, dur);
+  writer.push(1, dur); // joined in the input stream
+  writer.push(2, dur);
+  writer.commit();
+
+  EXPECT_EQ("0 s:(0.25,2 s)\n2 s:(0.5,1 s)\n", output(printer));
+}
+
+// the processor pushes through an existing writer of the output
+TEST_F(Processors, PipelineToWriter)
+{
+  process_stream::writer_type out("out", tracing::STREAM_CREATE);
+  test_printer<double> printer;
+  printer.in(out);
+
+  auto proc =
+    tracing::pipeline(writer).map([](int v) { return v * 1.5; }).to(out);
+
+  writer.push(1, dur);
+  writer.push(2, dur * 2);
+  writer.commit();
+
+  EXPECT_EQ("0 s:(1.5,1 s)\n1 s:(3,2 s)\n", output(printer));
+}
+
+TEST_F(Processors, ZipAlignment)
+{
+  process_stream voltage("voltage"), power("power");
+  state_stream::writer_type frequency("frequency", tracing::STREAM_CREATE);
+  test_printer<double> printer;
+  printer.in(power);
+
+  // the fixture writer provides the on/off state
+  auto proc = tracing::make_zip_processor(
+    [](double v, int on, int f) { return on ? v * f : 0.0; },
+    power,
+    voltage,
+    dynamic_cast<state_stream&>(writer.stream()),
+    dynamic_cast<state_stream&>(frequency.stream()));
+  EXPECT_TRUE(proc->batched);
+
+  process_stream::writer_type vw(voltage);
+  vw.push(4.0, dur * 2); // split into average segments
+  vw.push(1.0, dur);
+  writer.push(1, dur);
+  writer.push(0, dur);
+  writer.push(1, dur * 2);
+  frequency.push(10, dur * 3);
+  vw.commit();
+  writer.commit();
+  EXPECT_EQ("", output(printer));
+
+  frequency.commit();
+  EXPECT_EQ("0 s:(20,1 s)\n1 s:(0,1 s)\n2 s:(10,1 s)\n", output(printer));
+
+  // the pending tuple of the state input is aligned to the next tuples
+  vw.push(2.0, dur);
+  frequency.push(20, dur);
+  vw.commit();
+  frequency.commit();
+  EXPECT_EQ("3 s:(40,1 s)\n", output(printer));
+}
+
+TEST_F(Processors, ZipValues)
+{
+  typedef tracing::timed_state_traits<std::string> string_traits;
+  typedef tracing::timed_stream<std::string, string_traits> string_stream;
+  string_stream labels("labels"), out("out");
+  test_printer<std::string> printer;
+  printer.in(out);
+
+  auto proc = tracing::make_zip_processor(
+    [](int v, std::string const& l) { return l + std::to_string(v); },
+    out,
+    dynamic_cast<state_stream&>(writer.stream()),
+    labels);
+  EXPECT_FALSE(proc->batched);
+
+  string_stream::writer_type lw(labels);
+  writer.push(1, dur);
+  writer.push(2, dur);
+  lw.push("a", dur / 2);
+  lw.push("b", dur * 2);
+  writer.commit();
+  lw.commit();
+  EXPECT_EQ("0 s:(a1,0.5 s)\n0.5 s:(b1,0.5 s)\n1 s:(b2,1 s)\n",
+            output(printer));
+}
+
+TEST_F(Processors, EnergySegments)
+{
+  typedef tracing::timed_stream_energy_integrator integrator_type;
+  integrator_type::power_stream_type::writer_type cpu("cpu",
+                                                      tracing::STREAM_CREATE);
+  integrator_type::power_stream_type::writer_type mem("mem",
+                                                      tracing::STREAM_CREATE);
+  integrator_type::energy_stream_type energy("energy");
+  integrator_type::cumulative_stream_type cumulative("cumulative");
+
+  integrator_type integrator;
+  integrator.in(cpu);
+  integrator.in(mem);
+  integrator.energy_out(energy);
+  integrator.cumulative_out(cumulative);
+
+  test_printer<double> energy_printer, cumulative_printer;
+  energy_printer.in(energy);
+  cumulative_printer.in(cumulative);
+
+  cpu.push(2.0, dur);
+  cpu.push(4.0, dur);
+  mem.push(1.0, dur * 3);
+  cpu.commit();
+  mem.commit();
+
+  EXPECT_EQ("0 s:(3,1 s)\n1 s:(5,1 s)\n", output(energy_printer));
+  EXPECT_EQ("0 s:(3,1 s)\n1 s:(8,1 s)\n", output(cumulative_printer));
+  EXPECT_EQ(8.0 * sysx::si::joules, integrator.energy());
+  EXPECT_EQ(tracing::time_type(dur * 2), integrator.integrated_until());
+}
+
+TEST_F(Processors, EnergyWindows)
+{
+  typedef tracing::timed_stream_energy_integrator integrator_type;
+  integrator_type::power_stream_type::writer_type cpu("cpu",
+                                                      tracing::STREAM_CREATE);
+  integrator_type::energy_stream_type energy("energy");
+
+  integrator_type integrator(dur * 2);
+  integrator.in(cpu);
+  integrator.energy_out(energy);
+
+  test_printer<double> printer;
+  printer.in(energy);
+
+  cpu.push(1.0, dur);
+  cpu.push(3.0, dur * 2);
+  cpu.commit();
+
+  // the incomplete window is not emitted yet
+  EXPECT_EQ("0 s:(4,2 s)\n", output(printer));
+  EXPECT_EQ(7.0 * sysx::si::joules, integrator.energy());
+  EXPECT_EQ(3.0 * sysx::si::joules, integrator.window_energy());
+
+  cpu.push(0.5, dur * 4);
+  cpu.commit();
+  EXPECT_EQ("2 s:(3.5,2 s)\n4 s:(1,2 s)\n", output(printer));
+  EXPECT_EQ(0.5 * sysx::si::joules, integrator.window_energy());
+}
+
+// energy inputs are prorated over the covered part of their tuples
+TEST_F(Processors, EnergyProcessInputs)
+{
+  typedef tracing::timed_stream_energy_integrator integrator_type;
+  integrator_type::power_stream_type::writer_type cpu("cpu",
+                                                      tracing::STREAM_CREATE);
+  integrator_type::energy_stream_type::writer_type dma("dma",
+                                                       tracing::STREAM_CREATE);
+  integrator_type::energy_stream_type energy("energy");
+
+  integrator_type integrator(dur);
+  integrator.in(cpu);
+  integrator.in(dma);
+  integrator.energy_out(energy);
+
+  test_printer<double> printer;
+  printer.in(energy);
+
+  cpu.push(2.0, dur * 3);
+  dma.push(3.0, dur * 2);
+  dma.push(1.0, dur / 2);
+  dma.push(0.0, dur / 2);
+  cpu.commit();
+  dma.commit();
+
+  EXPECT_EQ("0 s:(3.5,1 s)\n1 s:(3.5,1 s)\n2 s:(3,1 s)\n",
+            output(printer));
+  EXPECT_EQ(10.0 * sysx::si::joules, integrator.energy());
+}
+
+// fractional segments in native double time do not hit the window end
+// exactly
+TEST_F(Processors, EnergyFractionalWindows)
+{
+  typedef tracing::timed_stream_energy_integrator integrator_type;
+  integrator_type::power_stream_type::writer_type cpu("cpu",
+                                                      tracing::STREAM_CREATE);
+  integrator_type::energy_stream_type energy("energy");
+  integrator_type::energy_stream_type::reader_type reader("reader", "energy");
+
+  integrator_type integrator(dur * 1e-6);
+  integrator.in(cpu);
+  integrator.energy_out(energy);
+
+  cpu.push(1.0, dur * 1.0473075977976086e-08);
+  cpu.push(2.0, dur * 1e-5);
+  cpu.commit();
+
+  EXPECT_NEAR(10e-6, tracing::to_seconds(reader.available_duration()), 1e-9);
+  EXPECT_NEAR(2e-5 + 1.0473075977976086e-08,
+              integrator.energy().value(),
+              1e-15);
+}
+
+TEST_F(Processors, CompensatedSum)
+{
+  sysx::utils::kahan_sum sum;
+  double naive = 1.0;
+  sum.add(1.0);
+  for (int i = 0; i < 10; ++i) {
+    sum.add(1e-16);
+    naive += 1e-16;
+  }
+  EXPECT_EQ(1.0, naive);
+  EXPECT_DOUBLE_EQ(1.0 + 1e-15, sum.value());
+}
+
+TEST_F(Processors, TumblingWindows)
+{
+  typedef tracing::timed_stream_window_aggregator<> aggregator_type;
+  aggregator_type::stream_type::writer_type in("in", tracing::STREAM_CREATE);
+  aggregator_type::stream_type mean("mean"), min("min"), max("max"),
+    rms("rms");
+
+  aggregator_type aggregator(dur * 2);
+  aggregator.in(in);
+  aggregator.mean_out(mean);
+  aggregator.min_out(min);
+  aggregator.max_out(max);
+  aggregator.rms_out(rms);
+
+  test_printer<double> mean_printer, min_printer, max_printer, rms_printer;
+  mean_printer.in(mean);
+  min_printer.in(min);
+  max_printer.in(max);
+  rms_printer.in(rms);
+
+  in.push(1.0, dur);
+  in.push(7.0, dur);
+  in.push(4.0, dur * 2);
+  in.push(0.0, dur * 3);
+  in.commit();
+
+  // the incomplete window is not emitted yet
+  EXPECT_EQ("0 s:(4,4 s)\n4 s:(0,2 s)\n", output(mean_printer));
+  EXPECT_EQ("0 s:(1,2 s)\n2 s:(4,2 s)\n4 s:(0,2 s)\n", output(min_printer));
+  EXPECT_EQ("0 s:(7,2 s)\n2 s:(4,2 s)\n4 s:(0,2 s)\n", output(max_printer));
+  EXPECT_EQ("0 s:(5,2 s)\n2 s:(4,2 s)\n4 s:(0,2 s)\n", output(rms_printer));
+}
+
+TEST_F(Processors, SlidingWindows)
+{
+  typedef tracing::timed_stream_window_aggregator<> aggregator_type;
+  aggregator_type::stream_type::writer_type in("in", tracing::STREAM_CREATE);
+  aggregator_type::stream_type mean("mean"), min("min"), max("max");
+
+  aggregator_type aggregator(dur * 2, dur);
+  aggregator.in(in);
+  aggregator.mean_out(mean);
+  aggregator.min_out(min);
+  aggregator.max_out(max);
+
+  test_printer<double> mean_printer, min_printer, max_printer;
+  mean_printer.in(mean);
+  min_printer.in(min);
+  max_printer.in(max);
+
+  in.push(1.0, dur);
+  in.push(7.0, dur);
+  in.push(4.0, dur * 2);
+  in.push(0.0, dur);
+  in.commit();
+
+  EXPECT_EQ("0 s:(1,1 s)\n1 s:(4,1 s)\n2 s:(5.5,1 s)\n3 s:(4,1 s)\n"
+            "4 s:(2,1 s)\n",
+            output(mean_printer));
+  EXPECT_EQ("0 s:(1,2 s)\n2 s:(4,2 s)\n4 s:(0,1 s)\n", output(min_printer));
+  EXPECT_EQ("0 s:(1,1 s)\n1 s:(7,2 s)\n3 s:(4,2 s)\n", output(max_printer));
+}
+
+// inexact multiples of the hop in native double time (0.3 / 0.1)
+TEST_F(Processors, FractionalHops)
+{
+  typedef tracing::timed_stream_window_aggregator<> aggregator_type;
+  aggregator_type::stream_type::writer_type in("in", tracing::STREAM_CREATE);
+  aggregator_type::stream_type mean("mean"), max("max");
+
+  aggregator_type aggregator(dur * 0.3, dur * 0.1);
+  aggregator_type wide(dur * 0.7, dur * 0.1);
+  aggregator.in(in);
+  aggregator.mean_out(mean);
+  wide.in(in);
+  wide.max_out(max);
+
+  aggregator_type::stream_type::reader_type mean_reader("mean_reader", "mean");
+  aggregator_type::stream_type::reader_type max_reader("max_reader", "max");
+
+  in.push(1.0, dur * 0.5);
+  in.push(3.0, dur * 0.5);
+  in.commit();
+
+  // all hops are completed
+  EXPECT_NEAR(1.0, tracing::to_seconds(mean_reader.available_duration()),
+              1e-9);
+  EXPECT_NEAR(1.0, tracing::to_seconds(max_reader.available_duration()),
+              1e-9);
+  EXPECT_EQ(1.0, mean_reader.get());
+  EXPECT_NEAR(7.0 / 3, mean_reader.get(dur * 0.65), 1e-9);
+  EXPECT_EQ(1.0, max_reader.get());
+  EXPECT_EQ(3.0, max_reader.get(dur * 0.95));
+}
+
+TEST_F(Processors, WindowPercentiles)
+{
+  typedef tracing::timed_stream_window_aggregator<> aggregator_type;
+  aggregator_type::stream_type::writer_type in("in", tracing::STREAM_CREATE);
+  aggregator_type::stream_type median("median"), p90("p90");
+
+  aggregator_type aggregator(dur * 100, dur * 10, 0.01);
+  aggregator.in(in);
+  aggregator.percentile_out(0.5, median);
+  aggregator.percentile_out(0.9, p90);
+
+  aggregator_type::stream_type::reader_type median_reader("median_reader",
+                                                          "median");
+  aggregator_type::stream_type::reader_type p90_reader("p90_reader", "p90");
+
+  for (int i = 1; i <= 100; ++i)
+    in.push(i, dur);
+  in.commit();
+
+  for (int i = 1; i < 10; ++i) {
+    median_reader.pop();
+    p90_reader.pop();
+  }
+  EXPECT_NEAR(50.0, median_reader.front().value(), 0.5);
+  EXPECT_NEAR(90.0, p90_reader.front().value(), 0.9);
+
+  // time-weighted: the long tuple dominates the next window
+  in.push(1000.0, dur * 60);
+  in.push(1.0, dur * 40);
+  in.commit();
+
+  // (equal adjacent windows are joined)
+  median_reader.pop();
+  p90_reader.pop();
+  while (median_reader.count() > 1)
+    median_reader.pop();
+  while (p90_reader.count() > 1)
+    p90_reader.pop();
+  EXPECT_NEAR(1000.0, median_reader.front().value(), 10.0);
+  EXPECT_NEAR(1000.0, p90_reader.front().value(), 10.0);
+}
+
+// process values are aggregated as their rate
+TEST_F(Processors, ProcessWindows)
+{
+  typedef tracing::timed_stream_window_aggregator<
+    double,
+    tracing::timed_process_traits<double>>
+    aggregator_type;
+  aggregator_type::input_type::writer_type in("in", tracing::STREAM_CREATE);
+  aggregator_type::stream_type mean("mean"), max("max");
+
+  aggregator_type aggregator(dur * 2);
+  aggregator.in(in);
+  aggregator.mean_out(mean);
+  aggregator.max_out(max);
+
+  test_printer<double> mean_printer, max_printer;
+  mean_printer.in(mean);
+  max_printer.in(max);
+
+  // 2 J within 1 s, 4 J within 2 s across the windows, 2 J within 1 s
+  in.push(2.0, dur);
+  in.push(4.0, dur * 2);
+  in.push(2.0, dur);
+  in.commit();
+
+  EXPECT_EQ("0 s:(2,4 s)\n", output(mean_printer));
+  EXPECT_EQ("0 s:(2,4 s)\n", output(max_printer));
+}
+
+// integral occupancy counters
+TEST_F(Processors, OccupancyWindows)
+{
+  typedef tracing::timed_stream_window_aggregator<int> aggregator_type;
+  aggregator_type::input_type::writer_type in("in", tracing::STREAM_CREATE);
+  aggregator_type::stream_type mean("mean"), max("max");
+
+  aggregator_type aggregator(dur * 2);
+  aggregator.in(in);
+  aggregator.mean_out(mean);
+  aggregator.max_out(max);
+
+  test_printer<double> mean_printer, max_printer;
+  mean_printer.in(mean);
+  max_printer.in(max);
+
+  in.push(1, dur);
+  in.push(4, dur);
+  in.push(2, dur * 2);
+  in.commit();
+
+  EXPECT_EQ("0 s:(2.5,2 s)\n2 s:(2,2 s)\n", output(mean_printer));
+  EXPECT_EQ("0 s:(4,2 s)\n2 s:(2,2 s)\n", output(max_printer));
+}
+
+TEST_F(Processors, QuantileSketch)
+{
+  sysx::utils::quantile_sketch a(0.01), b(0.01);
+  for (int i = 1; i <= 500; ++i)
+    a.add(i);
+  for (int i = 501; i <= 1000; ++i)
+    b.add(i);
+  b.add(-5.0, 10.0);
+
+  auto const buckets = a.buckets();
+  a.merge(b);
+  EXPECT_DOUBLE_EQ(1010.0, a.weight());
+  EXPECT_NEAR(-5.0, a.quantile(0.0), 0.05);
+  EXPECT_NEAR(495.0, a.quantile(0.5), 4.95);
+  EXPECT_NEAR(1000.0, a.quantile(1.0), 10.0);
+
+  // subtracting removes the emptied buckets again
+  a.subtract(b);
+  EXPECT_DOUBLE_EQ(500.0, a.weight());
+  EXPECT_EQ(buckets, a.buckets());
+  EXPECT_NEAR(1.0, a.quantile(0.0), 0.01);
+  EXPECT_NEAR(500.0, a.quantile(1.0), 5.0);
+}
+
+// a bucket is kept while it holds values, even if their weight is negligible
+TEST_F(Processors, PercentileTinyWeights)
+{
+  typedef tracing::timed_stream_window_aggregator<> aggregator_type;
+  aggregator_type::stream_type::writer_type in("in", tracing::STREAM_CREATE);
+  aggregator_type::stream_type median("median");
+
+  aggregator_type aggregator(dur * 2, dur, 0.01);
+  aggregator.in(in);
+  aggregator.percentile_out(0.5, median);
+
+  aggregator_type::stream_type::reader_type reader("reader", "median");
+
+  // 5.0 and 5.001 share a bucket
+  in.push(5.0, dur);
+  in.push(5.001, dur * 1e-12);
+  in.push(7.0, dur * (1 - 1e-12));
+  in.push(7.0, dur * 3);
+  in.commit();
+
+  EXPECT_NEAR(5.0, tracing::to_seconds(reader.available_duration()), 1e-9);
+  EXPECT_NEAR(7.0, reader.get(dur * 4.5), 0.07);
+}
+
+TEST_F(Processors, StateResidency)
+{
+  tracing::timed_state_residency<int> residency(writer);
+
+  writer.push(1, dur);
+  writer.push(2, dur * 2);
+  writer.push(1, dur);
+  writer.commit();
+
+  EXPECT_EQ(dur * 2, residency.residency(1));
+  EXPECT_EQ(dur * 2, residency.residency(2));
+  EXPECT_EQ(zero_time, residency.residency(3));
+  EXPECT_EQ(1u, residency.transitions(1, 2));
+  EXPECT_EQ(1u, residency.transitions(2, 1));
+  EXPECT_EQ(0u, residency.transitions(1, 1));
+
+  // the last state continues across the commit
+  writer.push(1, dur);
+  writer.push(3, dur);
+  writer.commit();
+
+  auto snapshot = residency.snapshot();
+  ASSERT_EQ(3u, snapshot.states.size());
+  EXPECT_EQ(1, snapshot.states[0]);
+  EXPECT_EQ(dur * 3, snapshot.residency[0]);
+  EXPECT_EQ(1u, snapshot.transitions[0][1]);
+  EXPECT_EQ(1u, snapshot.transitions[0][2]);
+  EXPECT_EQ(zero_time, snapshot.unknown);
+  EXPECT_EQ(tracing::time_type(dur * 6), snapshot.until);
+}
+
+TEST_F(Processors, EventResidency)
+{
+  tracing::timed_event_writer<int> events("events", tracing::STREAM_CREATE);
+  tracing::timed_event_residency<int> residency(events.stream());
+
+  // enter state 0 at 1 s, state 1 at 3 s, state 0 at 4 s
+  events.push(0, dur);
+  events.push(1, dur * 3);
+  events.push(0, dur * 4);
+  events.commit();
+  events.push(1, dur * 2);
+  events.commit();
+
+  EXPECT_EQ(dur, residency.unknown());
+  EXPECT_EQ(dur * 4, residency.residency(0));
+  EXPECT_EQ(dur, residency.residency(1));
+  EXPECT_EQ(2u, residency.transitions(0, 1));
+  EXPECT_EQ(1u, residency.transitions(1, 0));
+  EXPECT_EQ(tracing::time_type(dur * 6), residency.integrated_until());
+}
+
+TEST_F(Processors, DecimateProcess)
+{
+  process_stream::writer_type in("in", tracing::STREAM_CREATE);
+  process_stream out("out");
+  test_printer<double> printer;
+  printer.in(out);
+
+  tracing::timed_stream_decimator<double, process_traits> decimator(dur * 2);
+  decimator.in(in);
+  decimator.out(out);
+
+  in.push(4.0, dur);
+  in.push(2.0, dur * 2);
+  in.push(6.0, dur * 3);
+  in.commit();
+
+  // the totals are preserved
+  EXPECT_EQ("0 s:(5,2 s)\n2 s:(3,2 s)\n4 s:(4,2 s)\n", output(printer));
+}
+
+// fractional tuple durations in native double time do not hit the bucket
+// boundaries exactly
+TEST_F(Processors, DecimateFractional)
+{
+  process_stream::writer_type in("in", tracing::STREAM_CREATE);
+  process_stream out("out");
+  process_stream::reader_type reader("reader", "out");
+
+  tracing::timed_stream_decimator<double, process_traits> decimator(dur * 1e-6);
+  decimator.in(in);
+  decimator.out(out);
+
+  in.push(1.0, dur * 1e-8);
+  in.push(2.0, dur * 1e-5);
+  in.push(1.0, dur * 1.0473075977976086e-08);
+  in.push(2.0, dur * 1e-5);
+  in.commit();
+
+  // all but the last (incomplete) bucket are emitted, the total is preserved
+  EXPECT_NEAR(20e-6, tracing::to_seconds(reader.available_duration()), 1e-9);
+  double total = 0.0;
+  for (auto const& t : reader)
+    total += t.value();
+  EXPECT_NEAR(6.0 - 2.0 * 2.0473075977976086e-08 / 1e-5, total, 1e-9);
+}
+
+TEST_F(Processors, DecimateState)
+{
+  state_stream last("last"), mode("mode");
+  test_printer<int> last_printer, mode_printer;
+  last_printer.in(last);
+  mode_printer.in(mode);
+
+  tracing::timed_stream_decimator<int, state_traits> last_decimator(dur);
+  last_decimator.in(writer);
+  last_decimator.out(last);
+
+  typedef tracing::timed_reduction_mode<int, state_traits> mode_reduction;
+  tracing::timed_stream_decimator<int, state_traits, mode_reduction>
+    mode_decimator(dur);
+  mode_decimator.in(writer);
+  mode_decimator.out(mode);
+
+  writer.push(1, dur / 2);
+  writer.push(2, dur);
+  writer.push(3, dur * 2.5);
+  writer.push(4, dur);
+  writer.commit();
+
+  EXPECT_EQ("0 s:(2,1 s)\n1 s:(3,3 s)\n4 s:(4,1 s)\n", output(last_printer));
+  EXPECT_EQ("0 s:(1,1 s)\n1 s:(2,1 s)\n2 s:(3,2 s)\n4 s:(4,1 s)\n",
+            output(mode_printer));
+}
+
+TEST_F(Processors, DecimateEvents)
+{
+  typedef tracing::timed_event_writer<int> event_writer;
+  typedef event_writer::stream_type event_stream;
+  typedef event_writer::value_type event_set;
+
+  event_writer events("events", tracing::STREAM_CREATE);
+  event_stream out("out");
+  test_event_printer<int> printer;
+  printer.in(out);
+
+  tracing::timed_stream_decimator<event_set,
+                                  tracing::timed_event_traits<event_set>>
+    decimator(dur);
+  decimator.in(events.stream());
+  decimator.out(out);
+
+  events.push(0, dur / 2);
+  events.push(1, dur * 0.8);
+  events.push(2, dur * 2.5);
+  events.commit();
+  events.push(3, dur / 2);
+  events.commit();
+  events.push(4, dur * 3);
+  events.commit();
+
+  // empty buckets are not emitted individually
+  std::stringstream str;
+  printer.print(str);
+  EXPECT_EQ("@1 s: { 0, 1 }\n@2 s: { - }\n@3 s: { 2, 3 }\n@5 s: { - }\n"
+            "@6 s: { 4 }\n",
+            str.str());
+}
+
+TEST_F(Processors, BinopOperators)
+{
+  using tracing::operator_traits;
+  static_assert(operator_traits<int, tracing::minimum<int>>::identity ==
+                  std::numeric_limits<int>::max(),
+                "minimum identity");
+  static_assert(operator_traits<double, tracing::maximum<double>>::identity ==
+                  -std::numeric_limits<double>::infinity(),
+                "maximum identity");
+  static_assert(operator_traits<bool, std::logical_and<bool>>::identity,
+                "logical_and identity");
+  static_assert(operator_traits<int, std::multiplies<int>>::has_absorbing,
+                "integer multiplication by 0");
+  static_assert(
+    !operator_traits<double, std::multiplies<double>>::has_absorbing,
+    "0 * NaN is not 0");
+
+  state_stream::writer_type other("other", tracing::STREAM_CREATE);
+
+  tracing::timed_stream_processor_minus<int, state_traits> minus;
+  tracing::timed_stream_processor_minimum<int, state_traits> minimum;
+  tracing::timed_stream_processor_maximum<int, state_traits> maximum;
+  tracing::timed_stream_processor_multiplies<int, state_traits> multiplies;
+  tracing::timed_stream_processor_logical_and<int, state_traits> logical_and;
+  tracing::timed_stream_processor_bit_or<int, state_traits> bit_or;
+
+  state_stream out[6] = { state_stream("out0"), state_stream("out1"),
+                          state_stream("out2"), state_stream("out3"),
+                          state_stream("out4"), state_stream("out5") };
+  test_printer<int> printer[6];
+  auto bind = [&](auto& proc, int i) {
+    proc.in(writer);
+    proc.in(other);
+    proc.out(out[i]);
+    printer[i].in(out[i]);
+  };
+  bind(minus, 0);
+  bind(minimum, 1);
+  bind(maximum, 2);
+  bind(multiplies, 3);
+  bind(logical_and, 4);
+  bind(bit_or, 5);
+
+  writer.push(5, dur);
+  writer.push(0, dur * 2);
+  other.push(3, dur * 2);
+  other.push(6, dur);
+  writer.commit();
+  other.commit();
+
+  // folded from left to right in the order of the inputs
+  EXPECT_EQ("0 s:(2,1 s)\n1 s:(-3,1 s)\n2 s:(-6,1 s)\n", output(printer[0]));
+  EXPECT_EQ("0 s:(3,1 s)\n1 s:(0,2 s)\n", output(printer[1]));
+  EXPECT_EQ("0 s:(5,1 s)\n1 s:(3,1 s)\n2 s:(6,1 s)\n", output(printer[2]));
+  EXPECT_EQ("0 s:(15,1 s)\n1 s:(0,2 s)\n", output(printer[3]));
+  EXPECT_EQ("0 s:(1,1 s)\n1 s:(0,2 s)\n", output(printer[4]));
+  EXPECT_EQ("0 s:(7,1 s)\n1 s:(3,1 s)\n2 s:(6,1 s)\n", output(printer[5]));
+}
+
+/* Taf!
+ */
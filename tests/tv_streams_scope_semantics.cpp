@@ -0,0 +1,561 @@
+/*
+ * Copyright (c) 2018 OFFIS Institute for Information Technology
+ *                          Oldenburg, Germany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timed_stream_fixture.h"
+
+#include "tvs/tracing.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// native object hierarchy and scope-based synchronisation
+struct ScopeSemantics : public timed_stream_fixture_b
+{
+  using traits_type = tracing::timed_process_traits<double>;
+  using writer_type = tracing::timed_writer<double, traits_type>;
+  using reader_type = tracing::timed_reader<double, traits_type>;
+
+  ScopeSemantics()
+    : scope("cpu")
+  {}
+
+  tracing::object_scope scope;
+};
+
+TEST_F(ScopeSemantics, HierarchicalNames)
+{
+  tracing::host::scope_guard enter(scope);
+
+  writer_type writer("power", tracing::STREAM_CREATE);
+  auto& stream = writer.stream();
+
+  EXPECT_EQ(std::string("cpu.power"), stream.name());
+  EXPECT_EQ(std::string("power"), stream.basename());
+  EXPECT_EQ(&scope, stream.get_parent_object());
+
+  auto const& children = scope.get_child_objects();
+  EXPECT_NE(children.end(),
+            std::find(children.begin(), children.end(), &stream));
+
+  EXPECT_EQ(nullptr, scope.get_parent_object());
+  EXPECT_EQ(std::string("cpu"), tracing::host::current_object_name());
+}
+
+TEST_F(ScopeSemantics, NestedScopes)
+{
+  EXPECT_EQ(nullptr, tracing::host::current_scope());
+  {
+    tracing::host::scope_guard enter(scope);
+    tracing::object_scope core("core0");
+    EXPECT_EQ(std::string("cpu.core0"), core.name());
+    {
+      tracing::host::scope_guard enter_core(core);
+      EXPECT_EQ(&core, tracing::host::current_scope());
+
+      writer_type writer("power", tracing::STREAM_CREATE);
+      EXPECT_EQ(std::string("cpu.core0.power"), writer.stream().name());
+    }
+    EXPECT_EQ(&scope, tracing::host::current_scope());
+  }
+  EXPECT_EQ(nullptr, tracing::host::current_scope());
+  EXPECT_TRUE(scope.get_child_objects().empty());
+}
+
+TEST_F(ScopeSemantics, RelativeLookup)
+{
+  tracing::host::scope_guard enter(scope);
+
+  writer_type writer("power", tracing::STREAM_CREATE);
+
+  // relative to the current scope
+  reader_type local("local_reader", "power");
+  EXPECT_EQ(&writer.stream(), &local.stream());
+
+  // absolute hierarchical name
+  reader_type global("global_reader", "cpu.power");
+  EXPECT_EQ(&writer.stream(), &global.stream());
+}
+
+TEST_F(ScopeSemantics, UniqueNames)
+{
+  writer_type writer("taken", tracing::STREAM_CREATE);
+
+  // names of unused base names are passed through
+  EXPECT_EQ(std::string("unused"), tracing::host::gen_unique_name("unused"));
+
+  // generated names stay valid and distinct
+  std::vector<const char*> names;
+  for (int i = 0; i < 1000; ++i)
+    names.push_back(tracing::host::gen_unique_name("taken"));
+
+  std::vector<std::string> copies(names.begin(), names.end());
+  for (int i = 0; i < 1000; ++i)
+    names.push_back(tracing::host::gen_unique_name("taken"));
+
+  EXPECT_TRUE(std::equal(copies.begin(), copies.end(), names.begin()));
+  std::sort(copies.begin(), copies.end());
+  EXPECT_EQ(copies.end(), std::unique(copies.begin(), copies.end()));
+  EXPECT_EQ(copies.end(),
+            std::find(copies.begin(), copies.end(), std::string("taken")));
+
+  // typed lookup
+  using stream_type = writer_type::stream_type;
+  EXPECT_EQ(&writer.stream(), &tracing::stream_by_name<stream_type>("taken"));
+}
+
+TEST_F(ScopeSemantics, SyncScope)
+{
+  writer_type outside("outside", tracing::STREAM_CREATE);
+  outside.push(1.0, dur);
+
+  tracing::host::scope_guard enter(scope);
+
+  writer_type first("first", tracing::STREAM_CREATE);
+  writer_type second("second", tracing::STREAM_CREATE);
+
+  first.push(1.0, dur);
+  second.push(2.0, dur * 3);
+
+  // all streams in the scope are committed up to the maximum end time
+  auto until = tracing::sync();
+  EXPECT_EQ(tracing::time_type(dur * 3), until);
+  EXPECT_EQ(until, first.stream().local_time());
+  EXPECT_EQ(until, second.stream().local_time());
+
+  // streams outside of the scope are not affected
+  EXPECT_EQ(zero_time, outside.stream().local_time());
+}
+
+TEST_F(ScopeSemantics, SyncTopLevel)
+{
+  writer_type outside("outside", tracing::STREAM_CREATE);
+  outside.push(1.0, dur * 2);
+
+  {
+    tracing::host::scope_guard enter(scope);
+    writer_type inside("inside", tracing::STREAM_CREATE);
+    inside.push(1.0, dur);
+
+    tracing::sync(stamp);
+    EXPECT_EQ(stamp, inside.stream().local_time());
+  }
+
+  // without a scope, the top-level streams are synchronised
+  tracing::sync();
+  EXPECT_EQ(tracing::time_type(dur * 2), outside.stream().local_time());
+}
+
+/// pairs of writers summed up by a processor, each sum is printed
+struct sync_graph
+{
+  using traits_type = tracing::timed_process_traits<double>;
+  using writer_type = tracing::timed_writer<double, traits_type>;
+  using stream_type = tracing::timed_stream<double, traits_type>;
+  using plus_type = tracing::timed_stream_processor_plus<double, traits_type>;
+  using printer_type = test_printer<double>;
+
+  sync_graph(const char* nm, int pairs)
+    : scope(nm)
+  {
+    tracing::host::scope_guard enter(scope);
+    for (int i = 0; i < pairs; ++i) {
+      std::string idx = std::to_string(i);
+      writers.emplace_back(
+        new writer_type(("a" + idx).c_str(), tracing::STREAM_CREATE));
+      writers.emplace_back(
+        new writer_type(("b" + idx).c_str(), tracing::STREAM_CREATE));
+      sums.emplace_back(new stream_type(("sum" + idx).c_str()));
+
+      adders.emplace_back(new plus_type());
+      adders.back()->in(writers[2 * i]->name());
+      adders.back()->in(writers[2 * i + 1]->name());
+      adders.back()->out(*sums.back());
+
+      printers.emplace_back(new printer_type());
+      printers.back()->in(*sums.back());
+    }
+  }
+
+  std::vector<std::string> output() const
+  {
+    std::vector<std::string> ret;
+    for (auto& p : printers) {
+      std::stringstream str;
+      p->print(str);
+      ret.push_back(str.str());
+    }
+    return ret;
+  }
+
+  tracing::object_scope scope;
+  std::vector<std::unique_ptr<writer_type>> writers;
+  std::vector<std::unique_ptr<stream_type>> sums;
+  std::vector<std::unique_ptr<plus_type>> adders;
+  std::vector<std::unique_ptr<printer_type>> printers;
+};
+
+TEST_F(ScopeSemantics, ParallelSyncDeterminism)
+{
+  int const pairs = 16;
+  sync_graph serial("serial", pairs);
+  sync_graph parallel("parallel", pairs);
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> len(1, 4);
+
+  for (int round = 0; round < 10; ++round) {
+    for (std::size_t i = 0; i < serial.writers.size(); ++i) {
+      for (int j = len(gen); j > 0; --j) {
+        double value = len(gen);
+        auto d = dur * len(gen);
+        serial.writers[i]->push(value, d);
+        parallel.writers[i]->push(value, d);
+      }
+    }
+
+    tracing::time_type serial_until, parallel_until;
+    {
+      tracing::host::scope_guard enter(serial.scope);
+      serial_until = tracing::sync();
+    }
+    {
+      tracing::set_sync_concurrency(4);
+      tracing::host::scope_guard enter(parallel.scope);
+      parallel_until = tracing::sync();
+      tracing::set_sync_concurrency(1);
+    }
+    EXPECT_EQ(serial_until, parallel_until);
+  }
+
+  auto expected = serial.output();
+  EXPECT_EQ(expected, parallel.output());
+  EXPECT_FALSE(expected.front().empty());
+}
+
+/// summing stage recording the nesting depth of its output commits
+struct depth_probe
+  : tracing::timed_stream_processor_plus<double,
+                                         tracing::timed_process_traits<double>>
+{
+  static int active;
+  static int max_depth;
+
+protected:
+  duration_type do_commit(duration_type until) override
+  {
+    max_depth = std::max(max_depth, ++active);
+    auto ret = timed_stream_processor_base::do_commit(until);
+    --active;
+    return ret;
+  }
+};
+
+int depth_probe::active = 0;
+int depth_probe::max_depth = 0;
+
+/// a chain of stages, joined with a short branch at the end
+struct chain_graph
+{
+  using traits_type = tracing::timed_process_traits<double>;
+  using writer_type = tracing::timed_writer<double, traits_type>;
+  using stream_type = tracing::timed_stream<double, traits_type>;
+
+  chain_graph(const char* nm, int length)
+    : scope(nm)
+  {
+    tracing::host::scope_guard enter(scope);
+    writer.reset(new writer_type("source", tracing::STREAM_CREATE));
+
+    auto* source = dynamic_cast<stream_type*>(&writer->stream());
+    auto* prev = source;
+    for (int i = 0; i < length; ++i) {
+      streams.emplace_back(new stream_type(("s" + std::to_string(i)).c_str()));
+      stages.emplace_back(new depth_probe());
+      stages.back()->in(*prev);
+      stages.back()->out(*streams.back());
+      prev = streams.back().get();
+    }
+
+    // join the end of the chain with the source
+    streams.emplace_back(new stream_type("joined"));
+    stages.emplace_back(new depth_probe());
+    stages.back()->in(*prev);
+    stages.back()->in(*source);
+    stages.back()->out(*streams.back());
+    printer.in(*streams.back());
+  }
+
+  tracing::object_scope scope;
+  std::unique_ptr<writer_type> writer;
+  std::vector<std::unique_ptr<stream_type>> streams;
+  std::vector<std::unique_ptr<depth_probe>> stages;
+  test_printer<double> printer;
+};
+
+TEST_F(ScopeSemantics, DeferredNotification)
+{
+  int const length = 12;
+  chain_graph recursive("recursive", length);
+  chain_graph iterative("iterative", length);
+
+  auto run = [this](chain_graph& graph) {
+    depth_probe::max_depth = 0;
+    tracing::host::scope_guard enter(graph.scope);
+    for (int i = 1; i <= 5; ++i) {
+      graph.writer->push(i, dur * i);
+      tracing::sync();
+    }
+    return depth_probe::max_depth;
+  };
+
+  EXPECT_EQ(tracing::notify_mode::immediate, tracing::get_notify_mode());
+  EXPECT_EQ(length, run(recursive));
+
+  tracing::set_notify_mode(tracing::notify_mode::deferred);
+  EXPECT_EQ(1, run(iterative));
+  tracing::set_notify_mode(tracing::notify_mode::immediate);
+
+  std::stringstream expected, actual;
+  recursive.printer.print(expected);
+  iterative.printer.print(actual);
+  EXPECT_EQ(expected.str(), actual.str());
+  EXPECT_FALSE(expected.str().empty());
+}
+
+/// listener failing on its first notification
+struct failing_listener : tracing::timed_listener_if
+{
+  using reader_type = tracing::timed_reader<double, chain_graph::traits_type>;
+
+  explicit failing_listener(reader_type::stream_type& stream)
+    : in("failing_in", stream)
+  {
+    in.listen(*this);
+  }
+
+  void notify(tracing::timed_reader_base&) override
+  {
+    if (failed++ == 0)
+      throw std::runtime_error("listener failed");
+    in.pop_all();
+  }
+
+  reader_type in;
+  int failed = 0;
+};
+
+TEST_F(ScopeSemantics, DeferredNotificationError)
+{
+  using stream_type = chain_graph::stream_type;
+  tracing::object_scope failing("failing");
+  tracing::host::scope_guard enter(failing);
+
+  writer_type source_writer("source", tracing::STREAM_CREATE);
+  failing_listener listener(
+    dynamic_cast<stream_type&>(source_writer.stream()));
+
+  // the error propagates out of the commit, later commits still notify
+  tracing::set_notify_mode(tracing::notify_mode::deferred);
+  source_writer.push(1, dur);
+  EXPECT_THROW(tracing::sync(), std::runtime_error);
+  source_writer.push(2, dur);
+  EXPECT_NO_THROW(tracing::sync());
+  tracing::set_notify_mode(tracing::notify_mode::immediate);
+
+  EXPECT_EQ(2, listener.failed);
+  EXPECT_FALSE(listener.in.available());
+}
+
+/// independent branches of stages, summed up by a single stage
+struct wide_graph
+{
+  using traits_type = chain_graph::traits_type;
+  using writer_type = chain_graph::writer_type;
+  using stream_type = chain_graph::stream_type;
+  using stage_type =
+    tracing::timed_stream_processor_plus<double, traits_type>;
+
+  wide_graph(const char* nm, int width, int length)
+    : scope(nm)
+  {
+    tracing::host::scope_guard enter(scope);
+    writer.reset(new writer_type("source", tracing::STREAM_CREATE));
+    auto* source = dynamic_cast<stream_type*>(&writer->stream());
+
+    std::vector<stream_type*> ends;
+    for (int b = 0; b < width; ++b) {
+      auto* prev = source;
+      for (int i = 0; i < length; ++i) {
+        auto nm = "b" + std::to_string(b) + "_" + std::to_string(i);
+        streams.emplace_back(new stream_type(nm.c_str()));
+        stages.emplace_back(new stage_type());
+        stages.back()->in(*prev);
+        stages.back()->out(*streams.back());
+        prev = streams.back().get();
+      }
+      ends.push_back(prev);
+    }
+
+    streams.emplace_back(new stream_type("sum"));
+    stages.emplace_back(new stage_type());
+    for (auto* end : ends)
+      stages.back()->in(*end);
+    stages.back()->out(*streams.back());
+    printer.in(*streams.back());
+  }
+
+  std::string run(tracing::timed_duration const& dur)
+  {
+    tracing::host::scope_guard enter(scope);
+    for (int i = 1; i <= 8; ++i) {
+      writer->push(i % 3, dur * i);
+      tracing::sync();
+    }
+    std::stringstream out;
+    printer.print(out);
+    return out.str();
+  }
+
+  tracing::object_scope scope;
+  std::unique_ptr<writer_type> writer;
+  std::vector<std::unique_ptr<stream_type>> streams;
+  std::vector<std::unique_ptr<stage_type>> stages;
+  test_printer<double> printer;
+};
+
+TEST_F(ScopeSemantics, ParallelNotification)
+{
+  int const width = 6, length = 3;
+  wide_graph serial("serial_wide", width, length);
+  wide_graph parallel("parallel_wide", width, length);
+  wide_graph repeated("repeated_wide", width, length);
+
+  auto expected = serial.run(dur);
+  EXPECT_FALSE(expected.empty());
+
+  tracing::set_sync_concurrency(4);
+  tracing::set_notify_mode(tracing::notify_mode::parallel);
+  EXPECT_EQ(expected, parallel.run(dur));
+  EXPECT_EQ(expected, repeated.run(dur));
+  tracing::set_notify_mode(tracing::notify_mode::immediate);
+  tracing::set_sync_concurrency(1);
+}
+
+/// listener of streams of different ranks, checking that both have settled
+struct settled_probe : tracing::timed_listener_if
+{
+  using traits_type = chain_graph::traits_type;
+  using reader_type = tracing::timed_reader<double, traits_type>;
+
+  settled_probe(reader_type::stream_type& shallow,
+                reader_type::stream_type& deep)
+    : shallow_in("shallow_in", shallow)
+    , deep_in("deep_in", deep)
+  {
+    shallow_in.listen(*this);
+    deep_in.listen(*this);
+  }
+
+  void notify(tracing::timed_reader_base&) override
+  {
+    ++notified;
+    if (deep_in.available_until() < shallow_in.available_until())
+      ++unsettled;
+    auto settled = std::min(shallow_in.available_duration(),
+                            deep_in.available_duration());
+    if (settled > tracing::timed_duration::zero_time) {
+      shallow_in.pop_duration(settled);
+      deep_in.pop_duration(settled);
+    }
+  }
+
+  reader_type shallow_in;
+  reader_type deep_in;
+  int notified = 0;
+  int unsettled = 0;
+};
+
+TEST_F(ScopeSemantics, NotificationMixedRanks)
+{
+  using stream_type = chain_graph::stream_type;
+  using stage_type =
+    tracing::timed_stream_processor_plus<double, traits_type>;
+
+  for (auto mode :
+       { tracing::notify_mode::deferred, tracing::notify_mode::parallel }) {
+    tracing::object_scope mixed(mode == tracing::notify_mode::deferred
+                                  ? "mixed_deferred"
+                                  : "mixed_parallel");
+    tracing::host::scope_guard enter(mixed);
+
+    writer_type source_writer("source", tracing::STREAM_CREATE);
+    auto& source = dynamic_cast<stream_type&>(source_writer.stream());
+    stream_type staged("staged");
+
+    // the probe reads the source before the stage, which writes its input
+    settled_probe probe(source, staged);
+    stage_type stage;
+    stage.in(source);
+    stage.out(staged);
+
+    tracing::set_sync_concurrency(4);
+    tracing::set_notify_mode(mode);
+    for (int i = 1; i <= 8; ++i) {
+      source_writer.push(i, dur);
+      tracing::sync();
+    }
+    tracing::set_notify_mode(tracing::notify_mode::immediate);
+    tracing::set_sync_concurrency(1);
+
+    EXPECT_EQ(8, probe.notified);
+    EXPECT_EQ(0, probe.unsettled);
+  }
+}
+
+TEST_F(ScopeSemantics, DeferredNotificationPerSync)
+{
+  using stream_type = chain_graph::stream_type;
+  tracing::object_scope pair("pair");
+  tracing::host::scope_guard enter(pair);
+
+  writer_type first("first", tracing::STREAM_CREATE);
+  writer_type second("second", tracing::STREAM_CREATE);
+  settled_probe probe(dynamic_cast<stream_type&>(first.stream()),
+                      dynamic_cast<stream_type&>(second.stream()));
+
+  // the listener of both streams is only notified after both are committed
+  tracing::set_notify_mode(tracing::notify_mode::deferred);
+  for (int i = 1; i <= 4; ++i) {
+    first.push(i, dur);
+    second.push(i, dur);
+    tracing::sync();
+  }
+  tracing::set_notify_mode(tracing::notify_mode::immediate);
+
+  EXPECT_EQ(4, probe.notified);
+  EXPECT_FALSE(probe.shallow_in.available());
+  EXPECT_FALSE(probe.deep_in.available());
+}
+
+/* Taf!
+ */
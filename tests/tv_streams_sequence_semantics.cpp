@@ -21,9 +21,12 @@
 
 #include "gtest/gtest.h"
 
+#include <random>
+
 struct SequenceSemantics
   : public timed_stream_fixture<double, tracing::timed_process_traits<double>>
 {
+  typedef tracing::timed_process_traits<double> traits_type;
 
   void SetUp() override
   {
@@ -241,3 +244,353 @@ TEST_F(SequenceSemantics, CheckSplitSemantics)
 
   ASSERT_DEATH({ seq.split(inf); }, "");
 }
+
+// zero-time tuples at the start of the split tuple are kept
+TEST_F(SequenceSemantics, CheckSplitAfterZeroTime)
+{
+  sequence_type seq1;
+  seq1.push_back(0, dur);
+  seq1.push_back(tuple_type(5, zero_time), /* join = */ false);
+  seq1.push_back(7, dur * 2);
+
+  seq1.split(dur * 2);
+  expect_sequence(seq1, "{3 s; (0,1 s)(5,0 s)(3.5,1 s)(3.5,1 s) }");
+}
+
+TEST_F(SequenceSemantics, InfiniteTail)
+{
+  seq.push_back(3, inf);
+  EXPECT_TRUE(seq.is_infinite());
+  EXPECT_EQ(inf, seq.duration());
+  EXPECT_EQ(dur * 3, seq.finite_duration());
+
+  seq.pop_back();
+  EXPECT_FALSE(seq.is_infinite());
+  EXPECT_EQ(dur * 3, seq.duration());
+
+  seq.back(tuple_type(2, inf));
+  EXPECT_EQ(dur * 2, seq.finite_duration());
+  seq.pop_front(dur * 2);
+  EXPECT_EQ(inf, seq.duration());
+  EXPECT_EQ(zero_time, seq.finite_duration());
+}
+
+// the tracked duration always matches the sum of the tuple durations
+TEST_F(SequenceSemantics, DurationProperties)
+{
+  auto expected_duration = [](sequence_type const& s) {
+    tracing::timed_duration sum;
+    for (auto const& t : s)
+      sum += t.duration();
+    return sum;
+  };
+
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> op(0, 8);
+  std::uniform_int_distribution<int> len(0, 3);
+
+  sequence_type s;
+  for (int i = 0; i < 5000; ++i) {
+    bool open = s.empty() || !s.back().is_infinite();
+    switch (op(gen)) {
+      case 0:
+        if (open)
+          s.push_back(len(gen), dur * len(gen));
+        break;
+      case 1:
+        if (open)
+          s.push_back(len(gen), inf);
+        break;
+      case 2:
+        if (!s.empty())
+          s.pop_back();
+        break;
+      case 3:
+        if (!s.empty())
+          s.pop_front();
+        break;
+      case 4:
+        if (!s.empty() && !s.front().is_infinite())
+          s.pop_front(std::min(dur * len(gen), s.finite_duration()));
+        break;
+      case 5:
+        if (!s.empty() && !s.front().is_infinite())
+          s.front(tuple_type(1, dur * len(gen)));
+        break;
+      case 6:
+        if (!s.empty())
+          s.back(tuple_type(2, s.back().is_infinite() ? inf : dur * len(gen)));
+        break;
+      case 7:
+        if (s.finite_duration() > dur) // average split of finite tuples
+          s.split(dur * 0.5);
+        break;
+      case 8:
+        s.push_front(len(gen), dur * len(gen));
+        break;
+    }
+    ASSERT_EQ(expected_duration(s), s.duration()) << s;
+    ASSERT_EQ(!s.empty() && s.back().is_infinite(), s.is_infinite());
+  }
+}
+
+// windows clip the boundary tuples virtually (average split)
+TEST_F(SequenceSemantics, WindowView)
+{
+  tracing::timed_window_view<double, traits_type> view(
+    seq, dur * 0.5, dur * 2.5);
+
+  EXPECT_EQ(3u, view.size());
+  EXPECT_EQ(dur * 2, view.duration());
+
+  std::stringstream strs;
+  for (auto const& t : view)
+    strs << t;
+  EXPECT_EQ("(0,0.5 s)(1,1 s)(1,0.5 s)", strs.str());
+
+  // underlying sequence is unchanged
+  expect_sequence(seq, "{3 s; (0,1 s)(1,1 s)(2,1 s) }");
+
+  tracing::timed_window_view<double, traits_type> tail(seq, dur * 2, inf);
+  EXPECT_EQ(1u, tail.size());
+  EXPECT_EQ(dur, tail.duration());
+  EXPECT_TRUE((tracing::timed_window_view<double, traits_type>(
+                 seq, dur * 3, dur * 4)
+                 .empty()));
+
+  // empty windows within a tuple and at a tuple boundary
+  for (auto at : { dur * 0.5, dur }) {
+    tracing::timed_window_view<double, traits_type> point(seq, at, at);
+    EXPECT_TRUE(point.empty());
+    EXPECT_EQ(0u, point.size());
+    EXPECT_EQ(tracing::timed_duration(), point.duration());
+    EXPECT_TRUE(point.begin() == point.end());
+  }
+}
+
+TEST_F(SequenceSemantics, Cursor)
+{
+  tracing::timed_cursor<double, traits_type> cur(seq);
+
+  cur.advance(dur * 1.5);
+  EXPECT_EQ(dur * 1.5, cur.offset());
+  EXPECT_EQ(dur * 0.5, cur.remaining());
+  EXPECT_EQ(tuple_type(0.5, dur * 0.5), cur.tuple());
+
+  cur.next();
+  EXPECT_EQ(dur * 2, cur.offset());
+  EXPECT_EQ(2, cur.value());
+
+  cur.advance(dur);
+  EXPECT_TRUE(cur.at_end());
+  EXPECT_EQ(3u, seq.size());
+
+  // segments within a tuple, the last one moves to the next tuple
+  tracing::timed_cursor<double, traits_type> seg(seq);
+  seg.advance_segment(dur * 0.25);
+  EXPECT_EQ(dur * 0.75, seg.remaining());
+  seg.advance_segment(dur * 0.75);
+  EXPECT_EQ(dur, seg.offset());
+  EXPECT_EQ(seq.begin() + 1, seg.position());
+  EXPECT_EQ(tracing::timed_duration(), seg.skipped());
+}
+
+// reader windows leave the buffer untouched
+TEST_F(SequenceSemantics, ReaderWindow)
+{
+  writer.push(2, dur * 2);
+  writer.push(4, dur * 2);
+  writer.commit();
+
+  auto view = reader.window(dur, dur * 3);
+  double sum = 0;
+  for (auto const& t : view)
+    sum += t.value();
+  EXPECT_EQ(3, sum);
+  EXPECT_EQ(2u, reader.count());
+  EXPECT_EQ(dur * 2, reader.front_duration());
+}
+
+struct PackedSequenceSemantics : public timed_stream_fixture_b
+{
+  enum class power_state
+  {
+    OFF,
+    IDLE,
+    ACTIVE
+  };
+
+  template<typename Sequence>
+  std::string durations(Sequence const& s)
+  {
+    std::stringstream strs;
+    for (auto const& t : s)
+      strs << t.duration() << ";";
+    return strs.str();
+  }
+};
+
+TEST_F(PackedSequenceSemantics, PushAndIterate)
+{
+  tracing::timed_packed_sequence<bool> seq;
+  for (int i = 0; i < 20; ++i)
+    seq.push_back(i % 2 == 0, dur * (1 + i % 3));
+  seq.push_back(false, dur); // joins
+
+  EXPECT_EQ(20u, seq.size());
+  EXPECT_EQ(dur * 40, seq.duration());
+  EXPECT_EQ(dur * 3, seq.back().duration());
+
+  int i = 0;
+  for (auto const& t : seq) {
+    EXPECT_EQ(i % 2 == 0, t.value());
+    if (i < 19) {
+      EXPECT_EQ(dur * (1 + i % 3), t.duration());
+    }
+    ++i;
+  }
+  EXPECT_EQ(20, i);
+}
+
+TEST_F(PackedSequenceSemantics, PopFront)
+{
+  tracing::timed_packed_sequence<power_state> seq;
+  seq.push_back(power_state::IDLE, dur * 2);
+  seq.push_back(power_state::ACTIVE, dur);
+  seq.push_back(power_state::OFF, dur);
+
+  seq.pop_front(dur);
+  EXPECT_EQ(power_state::IDLE, seq.front().value());
+  EXPECT_EQ(dur, seq.front_duration());
+  EXPECT_EQ("1 s;1 s;1 s;", durations(seq));
+
+  seq.pop_front(dur * 2);
+  EXPECT_EQ(1u, seq.size());
+  EXPECT_EQ(power_state::OFF, seq.front().value());
+
+  seq.pop_front();
+  EXPECT_TRUE(seq.empty());
+  EXPECT_EQ(zero_time, seq.duration());
+}
+
+// long traces are compacted while being consumed
+TEST_F(PackedSequenceSemantics, Compaction)
+{
+  tracing::timed_packed_sequence<bool> seq;
+  for (int i = 0; i < 5000; ++i)
+    seq.push_back(i % 2 == 0, dur);
+
+  for (int i = 0; i < 4000; ++i)
+    seq.pop_front();
+
+  EXPECT_EQ(1000u, seq.size());
+  EXPECT_EQ(dur * 1000, seq.duration());
+  EXPECT_TRUE(seq.front().value());
+  EXPECT_EQ(dur, seq.front_duration());
+}
+
+// nanosecond-scale durations need two bytes per transition
+TEST_F(PackedSequenceSemantics, MemoryUsage)
+{
+  tracing::timed_packed_sequence<bool> seq;
+  for (int i = 0; i < 5000; ++i)
+    seq.push_back(i % 2 == 0, dur * 1e-9);
+
+  EXPECT_LT(seq.memory_usage() * 4,
+            seq.size() * sizeof(tracing::timed_value<bool>));
+}
+
+TEST_F(PackedSequenceSemantics, Recorder)
+{
+  typedef tracing::timed_writer<bool, tracing::timed_state_traits<bool>>
+    writer_type;
+
+  writer_type writer("packed_writer", tracing::STREAM_CREATE);
+  tracing::timed_packed_recorder<bool> recorder("packed_recorder",
+                                                writer.name());
+  writer.push(true, dur);
+  writer.push(false, dur);
+  writer.push(false, dur);
+  writer.commit();
+
+  auto const& seq = recorder.sequence();
+  EXPECT_EQ(2u, seq.size());
+  EXPECT_EQ(dur * 3, seq.duration());
+  EXPECT_EQ("1 s;2 s;", durations(seq));
+}
+
+struct CompressedSequenceSemantics : public timed_stream_fixture_b
+{
+  typedef tracing::timed_compressed_sequence<> sequence_type;
+
+  /// slowly changing power trace with repeating durations
+  static double power(int i) { return 0.5 + (i / 100) * 0.125; }
+};
+
+TEST_F(CompressedSequenceSemantics, Roundtrip)
+{
+  sequence_type seq;
+  int const n = 1000;
+  for (int i = 0; i < n; ++i)
+    seq.push_back(i % 7 == 0 ? -1.0 / 3 : power(i), dur * (1 + i % 2));
+
+  EXPECT_EQ(size_t(n), seq.size());
+  EXPECT_EQ(size_t(n / sequence_type::block_size), seq.blocks());
+
+  int i = 0;
+  for (auto const& t : seq) {
+    EXPECT_EQ(i % 7 == 0 ? -1.0 / 3 : power(i), t.value());
+    EXPECT_EQ(dur * (1 + i % 2), t.duration());
+    ++i;
+  }
+  EXPECT_EQ(n, i);
+}
+
+TEST_F(CompressedSequenceSemantics, PopAndAggregate)
+{
+  sequence_type seq;
+  double sum = 0;
+  for (int i = 0; i < 600; ++i) {
+    seq.push_back(power(i), dur);
+    if (i >= 300)
+      sum += power(i);
+  }
+
+  for (int i = 0; i < 300; ++i) {
+    EXPECT_EQ(power(i), seq.front().value());
+    seq.pop_front();
+  }
+
+  EXPECT_EQ(300u, seq.size());
+  EXPECT_EQ(1u, seq.blocks());
+  EXPECT_EQ(dur * 300, seq.duration());
+  EXPECT_DOUBLE_EQ(sum, seq.sum());
+  EXPECT_EQ(power(300), seq.min());
+  EXPECT_EQ(power(599), seq.max());
+}
+
+TEST_F(CompressedSequenceSemantics, Compression)
+{
+  sequence_type seq;
+  for (int i = 0; i < 4096; ++i)
+    seq.push_back(power(i), dur);
+
+  EXPECT_LT(seq.memory_usage() * 8,
+            seq.size() * sizeof(sequence_type::tuple_type));
+}
+
+TEST_F(CompressedSequenceSemantics, Recorder)
+{
+  typedef tracing::timed_process_traits<double> traits_type;
+  tracing::timed_writer<double, traits_type> writer("power_writer",
+                                                    tracing::STREAM_CREATE);
+  tracing::timed_compressed_recorder<> recorder("power_recorder",
+                                                writer.name());
+  for (int i = 0; i < 300; ++i)
+    writer.push(power(i), dur);
+  writer.commit();
+
+  EXPECT_EQ(300u, recorder.sequence().size());
+  EXPECT_EQ(1u, recorder.sequence().blocks());
+  EXPECT_EQ(power(299), recorder.sequence().max());
+}